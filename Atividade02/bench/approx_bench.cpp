@@ -0,0 +1,175 @@
+// Concordancia das distancias aproximadas (binary branches e pq-grams) com a
+// TED exata. Para cada tamanho, gera pares (arvore, copia com k edicoes
+// aleatorias), com k sorteado em [0, max-edits], e mede:
+//   - tempo de perfil + comparacao contra o tempo da TED;
+//   - correlacao de Spearman e fracao de pares de pares concordantes
+//     (Kendall) entre cada aproximacao e a TED;
+//   - violacoes da cota ceil(BDist / 5) <= TED (deve ser sempre 0).
+// Saida em JSON, um objeto por tamanho.
+//
+// Uso: approx_bench [--sizes 50,100,200] [--pairs 200] [--max-edits 20]
+//                   [--p 2] [--q 3] [--seed 1] [--out arquivo.json]
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "tree_approx.h"
+#include "tree_gen.h"
+
+struct BenchConfig {
+    std::vector<int> sizes = {50, 100, 200};
+    int pairs = 200;
+    int maxEdits = 20;
+    PqGramParams pq;
+    uint32_t seed = 1;
+};
+
+static std::vector<std::string> split(const std::string& s) {
+    std::vector<std::string> parts;
+    std::stringstream ss(s);
+    std::string item;
+    while (std::getline(ss, item, ','))
+        if (!item.empty()) parts.push_back(item);
+    return parts;
+}
+
+static double msSince(std::chrono::high_resolution_clock::time_point t0) {
+    return std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - t0).count();
+}
+
+// Postos medios (empates recebem a media das posicoes).
+static std::vector<double> ranks(const std::vector<double>& v) {
+    std::vector<int> idx(v.size());
+    std::iota(idx.begin(), idx.end(), 0);
+    std::sort(idx.begin(), idx.end(), [&](int a, int b) { return v[a] < v[b]; });
+    std::vector<double> r(v.size());
+    for (size_t i = 0; i < idx.size();) {
+        size_t j = i;
+        while (j < idx.size() && v[idx[j]] == v[idx[i]]) ++j;
+        for (size_t k = i; k < j; ++k) r[idx[k]] = (i + j - 1) / 2.0;
+        i = j;
+    }
+    return r;
+}
+
+static double spearman(const std::vector<double>& x, const std::vector<double>& y) {
+    std::vector<double> rx = ranks(x), ry = ranks(y);
+    double n = x.size(), mx = 0, my = 0;
+    for (size_t i = 0; i < x.size(); ++i) { mx += rx[i]; my += ry[i]; }
+    mx /= n; my /= n;
+    double sxy = 0, sxx = 0, syy = 0;
+    for (size_t i = 0; i < x.size(); ++i) {
+        sxy += (rx[i] - mx) * (ry[i] - my);
+        sxx += (rx[i] - mx) * (rx[i] - mx);
+        syy += (ry[i] - my) * (ry[i] - my);
+    }
+    return sxx > 0 && syy > 0 ? sxy / std::sqrt(sxx * syy) : 0;
+}
+
+// Fracao de pares (a, b) com TED distinta que a aproximacao ordena igual.
+static double concordance(const std::vector<double>& exact, const std::vector<double>& approx) {
+    long long agree = 0, total = 0;
+    for (size_t a = 0; a < exact.size(); ++a)
+        for (size_t b = a + 1; b < exact.size(); ++b) {
+            if (exact[a] == exact[b]) continue;
+            ++total;
+            if ((exact[a] < exact[b]) == (approx[a] < approx[b]) && approx[a] != approx[b]) ++agree;
+        }
+    return total ? (double)agree / total : 1;
+}
+
+static std::string runSize(int n, const BenchConfig& cfg) {
+    std::mt19937 rng(cfg.seed);
+    std::vector<double> ted, bdist, pqgram;
+    double tedMs = 0, branchMs = 0, pqMs = 0;
+    int violations = 0;
+    double boundRatio = 0;
+    int positive = 0;
+    for (int k = 0; k < cfg.pairs; ++k) {
+        TreeGenParams params;
+        params.nodes = n;
+        params.seed = cfg.seed + 7919u * k;
+        int edits = std::uniform_int_distribution<int>(0, cfg.maxEdits)(rng);
+        TreePair pair = generateMutatedPair(params, edits);
+        PostorderTree t1 = preprocessTree(pair.original);
+        PostorderTree t2 = preprocessTree(pair.mutated);
+
+        auto t0 = std::chrono::high_resolution_clock::now();
+        int d = treeEditDistance(t1, t2);
+        tedMs += msSince(t0);
+
+        t0 = std::chrono::high_resolution_clock::now();
+        int bd = binaryBranchDistance(t1, t2);
+        branchMs += msSince(t0);
+
+        t0 = std::chrono::high_resolution_clock::now();
+        double pd = pqGramDistance(t1, t2, cfg.pq);
+        pqMs += msSince(t0);
+
+        if (binaryBranchLowerBound(bd) > d) ++violations;
+        if (d > 0) {
+            boundRatio += binaryBranchLowerBound(bd) / (double)d;
+            ++positive;
+        }
+        ted.push_back(d);
+        bdist.push_back(bd);
+        pqgram.push_back(pd);
+    }
+    std::ostringstream out;
+    out << "{\"n\": " << n << ", \"pairs\": " << cfg.pairs << ", \"max_edits\": " << cfg.maxEdits
+        << ", \"p\": " << cfg.pq.p << ", \"q\": " << cfg.pq.q << ", \"seed\": " << cfg.seed
+        << ", \"ted_ms\": " << tedMs << ", \"bdist_ms\": " << branchMs << ", \"pqgram_ms\": " << pqMs
+        << ", \"bdist_spearman\": " << spearman(ted, bdist) << ", \"pqgram_spearman\": " << spearman(ted, pqgram)
+        << ", \"bdist_concordance\": " << concordance(ted, bdist)
+        << ", \"pqgram_concordance\": " << concordance(ted, pqgram)
+        << ", \"bdist_bound_ratio\": " << (positive ? boundRatio / positive : 1)
+        << ", \"bdist_bound_violations\": " << violations << "}";
+    return out.str();
+}
+
+int main(int argc, char** argv) {
+    BenchConfig cfg;
+    std::string outPath;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--sizes" && hasValue) {
+            cfg.sizes.clear();
+            for (const auto& s : split(argv[++i])) cfg.sizes.push_back(std::atoi(s.c_str()));
+        } else if (arg == "--pairs" && hasValue) {
+            cfg.pairs = std::atoi(argv[++i]);
+        } else if (arg == "--max-edits" && hasValue) {
+            cfg.maxEdits = std::atoi(argv[++i]);
+        } else if (arg == "--p" && hasValue) {
+            cfg.pq.p = std::atoi(argv[++i]);
+        } else if (arg == "--q" && hasValue) {
+            cfg.pq.q = std::atoi(argv[++i]);
+        } else if (arg == "--seed" && hasValue) {
+            cfg.seed = std::strtoul(argv[++i], nullptr, 10);
+        } else if (arg == "--out" && hasValue) {
+            outPath = argv[++i];
+        } else {
+            std::cerr << "Uso: approx_bench [--sizes 50,100] [--pairs 200] [--max-edits 20] [--p 2] [--q 3] [--seed 1] [--out arquivo.json]\n";
+            return 1;
+        }
+    }
+
+    std::ofstream file;
+    if (!outPath.empty()) file.open(outPath);
+    std::ostream& out = outPath.empty() ? std::cout : file;
+
+    out << "[\n";
+    for (size_t i = 0; i < cfg.sizes.size(); ++i) {
+        out << (i ? ",\n  " : "  ") << runSize(cfg.sizes[i], cfg);
+        out.flush();
+    }
+    out << "\n]\n";
+    return 0;
+}
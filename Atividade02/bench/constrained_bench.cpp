@@ -0,0 +1,110 @@
+// Distancia restrita (Zhang 1996) e top-down (Selkow) contra a TED sem
+// restricao, nas formas canonicas de tree_gen.h. Para cada caso, reporta as
+// tres distancias (onde divergem) e o tempo de cada uma (quanto se
+// economiza). Saida em JSON, um objeto por caso.
+//
+// Uso: constrained_bench [--sizes 128,256,512] [--shapes left-deep,star,...]
+//                        [--seed 1] [--edits k] [--out arquivo.json]
+//
+// Com --edits, T2 eh uma copia de T1 com k edicoes aleatorias (mutateTree);
+// sem ele, T2 eh outra arvore da mesma forma.
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "tree_constrained.h"
+#include "tree_gen.h"
+
+static std::vector<std::string> split(const std::string& s) {
+    std::vector<std::string> parts;
+    std::stringstream ss(s);
+    std::string item;
+    while (std::getline(ss, item, ','))
+        if (!item.empty()) parts.push_back(item);
+    return parts;
+}
+
+static double msSince(std::chrono::high_resolution_clock::time_point t0) {
+    return std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - t0).count();
+}
+
+static std::string runCase(TreeShape shape, int n, uint32_t seed, int edits) {
+    CompactTree a = makeShapeTree(shape, n, seed);
+    CompactTree b = edits >= 0 ? mutateTree(a, edits, seed + 1) : makeShapeTree(shape, n, seed + 1);
+    PostorderTree t1 = preprocessTree(a);
+    PostorderTree t2 = preprocessTree(b);
+
+    auto t0 = std::chrono::high_resolution_clock::now();
+    int ted = treeEditDistance(t1, t2);
+    double tedMs = msSince(t0);
+    t0 = std::chrono::high_resolution_clock::now();
+    int constrained = constrainedEditDistance(t1, t2);
+    double constrainedMs = msSince(t0);
+    t0 = std::chrono::high_resolution_clock::now();
+    int topDown = topDownEditDistance(t1, t2);
+    double topDownMs = msSince(t0);
+
+    std::ostringstream out;
+    out << "{\"shape\": \"" << shapeName(shape) << "\", \"n\": " << n << ", \"seed\": " << seed
+        << ", \"edits\": " << edits << ", \"ted\": " << ted << ", \"constrained\": " << constrained
+        << ", \"top_down\": " << topDown << ", \"ted_ms\": " << tedMs << ", \"constrained_ms\": " << constrainedMs
+        << ", \"top_down_ms\": " << topDownMs
+        << ", \"constrained_speedup\": " << (constrainedMs > 0 ? tedMs / constrainedMs : 0)
+        << ", \"top_down_speedup\": " << (topDownMs > 0 ? tedMs / topDownMs : 0) << "}";
+    return out.str();
+}
+
+int main(int argc, char** argv) {
+    std::vector<int> sizes = {128, 256, 512};
+    std::vector<TreeShape> shapes = {TreeShape::LeftDeep, TreeShape::RightDeep, TreeShape::FullBinary,
+                                     TreeShape::Star, TreeShape::RandomParent, TreeShape::ZigZag};
+    uint32_t seed = 1;
+    int edits = -1;
+    std::string outPath;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--sizes" && hasValue) {
+            sizes.clear();
+            for (const auto& s : split(argv[++i])) sizes.push_back(std::atoi(s.c_str()));
+        } else if (arg == "--shapes" && hasValue) {
+            shapes.clear();
+            for (const auto& s : split(argv[++i])) {
+                TreeShape shape;
+                if (!shapeFromName(s, shape)) {
+                    std::cerr << "Forma desconhecida: " << s << "\n";
+                    return 1;
+                }
+                shapes.push_back(shape);
+            }
+        } else if (arg == "--seed" && hasValue) {
+            seed = std::strtoul(argv[++i], nullptr, 10);
+        } else if (arg == "--edits" && hasValue) {
+            edits = std::atoi(argv[++i]);
+        } else if (arg == "--out" && hasValue) {
+            outPath = argv[++i];
+        } else {
+            std::cerr << "Uso: constrained_bench [--sizes 128,256] [--shapes left-deep,star] [--seed 1] [--edits k] [--out arquivo.json]\n";
+            return 1;
+        }
+    }
+
+    std::ofstream file;
+    if (!outPath.empty()) file.open(outPath);
+    std::ostream& out = outPath.empty() ? std::cout : file;
+
+    out << "[\n";
+    bool first = true;
+    for (TreeShape shape : shapes) {
+        for (int n : sizes) {
+            out << (first ? "  " : ",\n  ") << runCase(shape, n, seed, edits);
+            out.flush();
+            first = false;
+        }
+    }
+    out << "\n]\n";
+    return 0;
+}
@@ -0,0 +1,114 @@
+// TED incremental contra o calculo completo em versoes sucessivas de um
+// documento. T1 eh fixa; cada nova versao de T2 tem algumas edicoes
+// aleatorias (mutateTree) em relacao a anterior. Para cada tamanho, reporta
+// os tempos medios por versao, a fracao de pares de keyroots recalculados e
+// a razao de celulas calculadas. Saida em JSON.
+//
+// Uso: incremental_bench [--sizes 500,1000,2000] [--versions 10] [--edits 2]
+//                        [--seed 1] [--out arquivo.json]
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "tree_gen.h"
+#include "tree_incremental.h"
+
+static std::vector<std::string> split(const std::string& s) {
+    std::vector<std::string> parts;
+    std::stringstream ss(s);
+    std::string item;
+    while (std::getline(ss, item, ','))
+        if (!item.empty()) parts.push_back(item);
+    return parts;
+}
+
+static double msSince(std::chrono::high_resolution_clock::time_point t0) {
+    return std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - t0).count();
+}
+
+static std::string runSize(int n, int versions, int edits, uint32_t seed) {
+    TreeGenParams params;
+    params.nodes = n;
+    params.seed = seed;
+    CompactTree base = generateTree(params);
+    PostorderTree t1 = preprocessTree(mutateTree(base, edits * 4, seed + 1));
+    CompactTree doc = base;
+
+    IncrementalTed inc;
+    IncrementalStats st;
+    inc.compare(t1, preprocessTree(doc), &st); // primeira versao: calculo completo
+
+    double fullMs = 0, incMs = 0;
+    long long fullCells = 0, incCells = 0, pairs = 0, recomputed = 0, moved = 0;
+    int mismatches = 0;
+    for (int v = 1; v <= versions; ++v) {
+        doc = mutateTree(doc, edits, seed + 100 + v);
+        PostorderTree t2 = preprocessTree(doc);
+
+        TedStats stats;
+        TedOptions options;
+        options.stats = &stats;
+        auto t0 = std::chrono::high_resolution_clock::now();
+        int full = treeEditDistance(t1, t2, options);
+        fullMs += msSince(t0);
+        fullCells += stats.cells;
+
+        t0 = std::chrono::high_resolution_clock::now();
+        int d = inc.compare(t1, t2, &st);
+        incMs += msSince(t0);
+        incCells += st.cells;
+        moved += st.movedCells;
+        pairs += st.keyrootPairs;
+        recomputed += st.recomputedPairs;
+        if (d != full) ++mismatches;
+    }
+    std::ostringstream out;
+    out << "{\"n\": " << n << ", \"versions\": " << versions << ", \"edits\": " << edits << ", \"seed\": " << seed
+        << ", \"full_ms\": " << fullMs / versions << ", \"incremental_ms\": " << incMs / versions
+        << ", \"speedup\": " << (incMs > 0 ? fullMs / incMs : 0)
+        << ", \"recomputed_pairs\": " << (pairs ? (double)recomputed / pairs : 0)
+        << ", \"cells_ratio\": " << (fullCells ? (double)incCells / fullCells : 0)
+        << ", \"moved_cells\": " << moved / versions << ", \"mismatches\": " << mismatches << "}";
+    return out.str();
+}
+
+int main(int argc, char** argv) {
+    std::vector<int> sizes = {500, 1000, 2000};
+    int versions = 10, edits = 2;
+    uint32_t seed = 1;
+    std::string outPath;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--sizes" && hasValue) {
+            sizes.clear();
+            for (const auto& s : split(argv[++i])) sizes.push_back(std::atoi(s.c_str()));
+        } else if (arg == "--versions" && hasValue) {
+            versions = std::atoi(argv[++i]);
+        } else if (arg == "--edits" && hasValue) {
+            edits = std::atoi(argv[++i]);
+        } else if (arg == "--seed" && hasValue) {
+            seed = std::strtoul(argv[++i], nullptr, 10);
+        } else if (arg == "--out" && hasValue) {
+            outPath = argv[++i];
+        } else {
+            std::cerr << "Uso: incremental_bench [--sizes 500,1000] [--versions 10] [--edits 2] [--seed 1] [--out arquivo.json]\n";
+            return 1;
+        }
+    }
+
+    std::ofstream file;
+    if (!outPath.empty()) file.open(outPath);
+    std::ostream& out = outPath.empty() ? std::cout : file;
+
+    out << "[\n";
+    for (size_t i = 0; i < sizes.size(); ++i) {
+        out << (i ? ",\n  " : "  ") << runSize(sizes[i], versions, edits, seed);
+        out.flush();
+    }
+    out << "\n]\n";
+    return 0;
+}
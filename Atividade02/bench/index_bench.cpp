@@ -0,0 +1,140 @@
+// VP-tree (tree_index.h) contra a busca linear. O corpus tem grupos de
+// arvores parecidas (copias de uma base com algumas edicoes), e as consultas
+// sao copias editadas de arvores do corpus. Para k-NN e busca por raio,
+// reporta as avaliacoes de TED por consulta e o tempo, e confere que as
+// distancias sao as mesmas da busca linear. Com --save, grava o indice,
+// recarrega e repete as consultas. Saida em JSON.
+//
+// Uso: index_bench [--trees 2000] [--nodes 30] [--clusters 50] [--edits 6]
+//                  [--queries 50] [--k 5] [--radius 4] [--threads 0]
+//                  [--seed 1] [--save arquivo.idx]
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include "tree_gen.h"
+#include "tree_index.h"
+
+static double msSince(std::chrono::high_resolution_clock::time_point t0) {
+    return std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - t0).count();
+}
+
+static std::vector<int> distances(const std::vector<IndexMatch>& matches) {
+    std::vector<int> d;
+    for (const auto& m : matches) d.push_back(m.distance);
+    return d;
+}
+
+int main(int argc, char** argv) {
+    int treeCount = 2000, nodes = 30, clusters = 50, edits = 6, queryCount = 50, k = 5, radius = 4, threads = 0;
+    uint32_t seed = 1;
+    std::string savePath;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--trees" && hasValue) treeCount = std::atoi(argv[++i]);
+        else if (arg == "--nodes" && hasValue) nodes = std::atoi(argv[++i]);
+        else if (arg == "--clusters" && hasValue) clusters = std::atoi(argv[++i]);
+        else if (arg == "--edits" && hasValue) edits = std::atoi(argv[++i]);
+        else if (arg == "--queries" && hasValue) queryCount = std::atoi(argv[++i]);
+        else if (arg == "--k" && hasValue) k = std::atoi(argv[++i]);
+        else if (arg == "--radius" && hasValue) radius = std::atoi(argv[++i]);
+        else if (arg == "--threads" && hasValue) threads = std::atoi(argv[++i]);
+        else if (arg == "--seed" && hasValue) seed = std::strtoul(argv[++i], nullptr, 10);
+        else if (arg == "--save" && hasValue) savePath = argv[++i];
+        else {
+            std::cerr << "Uso: index_bench [--trees 2000] [--nodes 30] [--clusters 50] [--edits 6] [--queries 50]"
+                         " [--k 5] [--radius 4] [--threads 0] [--seed 1] [--save arquivo.idx]\n";
+            return 1;
+        }
+    }
+    if (clusters < 1) clusters = 1;
+
+    std::mt19937 rng(seed);
+    std::vector<CompactTree> bases;
+    for (int c = 0; c < clusters; ++c) {
+        TreeGenParams params;
+        params.nodes = nodes;
+        params.seed = seed + c;
+        bases.push_back(generateTree(params));
+    }
+    std::vector<PostorderTree> corpus;
+    for (int i = 0; i < treeCount; ++i) {
+        int e = std::uniform_int_distribution<int>(0, edits)(rng);
+        corpus.push_back(preprocessTree(mutateTree(bases[i % clusters], e, seed * 7919u + i)));
+    }
+    std::vector<PostorderTree> queries;
+    for (int q = 0; q < queryCount; ++q) {
+        int source = std::uniform_int_distribution<int>(0, treeCount - 1)(rng);
+        queries.push_back(preprocessTree(mutateTree(bases[source % clusters], 2, seed * 104729u + q)));
+    }
+
+    VpTreeIndex index;
+    IndexBuildStats build;
+    index.build(corpus, threads, seed, &build);
+
+    auto runQueries = [&](const VpTreeIndex& idx, long long& knnEvals, long long& rangeEvals, double& knnMs,
+                          double& rangeMs, double& linearMs, int& mismatches) {
+        knnEvals = rangeEvals = 0;
+        knnMs = rangeMs = linearMs = 0;
+        mismatches = 0;
+        for (const auto& q : queries) {
+            IndexQueryStats st;
+            auto t0 = std::chrono::high_resolution_clock::now();
+            auto near = idx.knn(q, k, &st);
+            knnMs += msSince(t0);
+            knnEvals += st.tedEvaluations;
+
+            t0 = std::chrono::high_resolution_clock::now();
+            auto within = idx.range(q, radius, &st);
+            rangeMs += msSince(t0);
+            rangeEvals += st.tedEvaluations;
+
+            t0 = std::chrono::high_resolution_clock::now();
+            auto all = linearKnn(corpus, q, treeCount);
+            linearMs += msSince(t0);
+            std::vector<IndexMatch> expectNear(all.begin(), all.begin() + std::min<size_t>(k, all.size()));
+            std::vector<IndexMatch> expectWithin;
+            for (const auto& m : all)
+                if (m.distance <= radius) expectWithin.push_back(m);
+            if (distances(near) != distances(expectNear)) ++mismatches;
+            if (distances(within) != distances(expectWithin)) ++mismatches;
+            for (size_t i = 0; i < within.size() && i < expectWithin.size(); ++i)
+                if (within[i].id != expectWithin[i].id) {
+                    ++mismatches;
+                    break;
+                }
+        }
+    };
+
+    long long knnEvals, rangeEvals;
+    double knnMs, rangeMs, linearMs;
+    int mismatches;
+    runQueries(index, knnEvals, rangeEvals, knnMs, rangeMs, linearMs, mismatches);
+
+    std::cout << "{\"trees\": " << treeCount << ", \"nodes\": " << nodes << ", \"clusters\": " << clusters
+              << ", \"edits\": " << edits << ", \"queries\": " << queryCount << ", \"k\": " << k
+              << ", \"radius\": " << radius << ", \"seed\": " << seed
+              << ", \"build_ms\": " << build.ms << ", \"build_ted_evaluations\": " << build.tedEvaluations
+              << ", \"knn_ted_per_query\": " << (double)knnEvals / queryCount
+              << ", \"range_ted_per_query\": " << (double)rangeEvals / queryCount
+              << ", \"linear_ted_per_query\": " << treeCount
+              << ", \"knn_ms_per_query\": " << knnMs / queryCount << ", \"range_ms_per_query\": " << rangeMs / queryCount
+              << ", \"linear_ms_per_query\": " << linearMs / queryCount << ", \"mismatches\": " << mismatches;
+
+    if (!savePath.empty()) {
+        try {
+            index.save(savePath);
+            VpTreeIndex loaded;
+            loaded.load(savePath, corpus);
+            runQueries(loaded, knnEvals, rangeEvals, knnMs, rangeMs, linearMs, mismatches);
+            std::cout << ", \"reloaded_mismatches\": " << mismatches;
+        } catch (const std::exception& e) {
+            std::cout << ", \"error\": \"" << e.what() << "\"";
+        }
+    }
+    std::cout << "}\n";
+    return 0;
+}
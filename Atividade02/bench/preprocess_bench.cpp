@@ -0,0 +1,62 @@
+// Benchmark do pre-processamento iterativo (pos-ordem, lld, keyroots e
+// tamanhos) em arvores de 10^7 nos. Formas que estouravam a pilha na versao
+// recursiva (caminho de profundidade n) fazem parte da bateria.
+//
+// Uso: preprocess_bench [nos CompactTree = 10000000] [nos Node* = 1000000]
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include "tree_arena.h"
+
+static CompactTree makeTree(const std::string& shape, int n) {
+    CompactTree tree;
+    tree.reserve(n);
+    std::mt19937 rng(42);
+    tree.addNode(0);
+    for (int i = 1; i < n; ++i) {
+        int parent;
+        if (shape == "caminho") parent = i - 1;
+        else if (shape == "estrela") parent = 0;
+        else parent = std::uniform_int_distribution<int>(0, i - 1)(rng);
+        tree.addNode(i % 26, parent);
+    }
+    return tree;
+}
+
+template <typename F>
+static double timeMs(F&& f) {
+    auto t0 = std::chrono::high_resolution_clock::now();
+    f();
+    auto t1 = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration<double, std::milli>(t1 - t0).count();
+}
+
+static void report(const char* input, const std::string& shape, int n, double ms, const PostorderTree& t) {
+    std::cout << input << " " << shape << ": " << n << " nos em " << ms << " ms ("
+              << (n / 1e6) / (ms / 1000.0) << " M nos/s), " << t.keyroots.size() << " keyroots\n";
+}
+
+int main(int argc, char** argv) {
+    int n = argc > 1 ? std::atoi(argv[1]) : 10000000;
+    int nodeN = argc > 2 ? std::atoi(argv[2]) : 1000000;
+
+    LabelDictionary dict;
+    for (int c = 0; c < 26; ++c) dict.intern(std::string(1, 'A' + c));
+
+    for (const std::string shape : {"pai-aleatorio", "caminho", "estrela"}) {
+        CompactTree tree = makeTree(shape, n);
+        PostorderTree pre;
+        double ms = timeMs([&] { pre = preprocessTree(tree); });
+        report("CompactTree", shape, n, ms, pre);
+
+        if (nodeN > 0) {
+            CompactTree small = makeTree(shape, nodeN);
+            NodeArena arena;
+            Node* root = toNodeTree(small, dict, arena);
+            ms = timeMs([&] { pre = preprocessTree(root, dict); });
+            report("Node*      ", shape, nodeN, ms, pre);
+        }
+    }
+    return 0;
+}
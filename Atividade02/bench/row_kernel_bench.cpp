@@ -0,0 +1,166 @@
+// Microbenchmark da varredura de linha do forestdist (tree_simd.h): cada
+// kernel suportado pela CPU contra o laco escalar, em linhas de uint16 e
+// int32, e o Zhang-Shasha completo com o kernel escalar e com o automatico.
+// Antes de medir, confere que todos os kernels produzem a mesma linha.
+// Saida em JSON.
+//
+// Uso: row_kernel_bench [--cols 64,512,4096] [--sizes 512] [--shapes random-parent,zig-zag]
+//                       [--seed 1] [--out arquivo.json]
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "tree_edit.h"
+#include "tree_gen.h"
+
+static std::vector<std::string> split(const std::string& s) {
+    std::vector<std::string> parts;
+    std::stringstream ss(s);
+    std::string item;
+    while (std::getline(ss, item, ','))
+        if (!item.empty()) parts.push_back(item);
+    return parts;
+}
+
+static double msSince(std::chrono::high_resolution_clock::time_point t0) {
+    return std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - t0).count();
+}
+
+static std::vector<RowKernel> availableKernels() {
+    std::vector<RowKernel> kernels;
+    for (RowKernel k : {RowKernel::Scalar, RowKernel::Sse41, RowKernel::Avx2})
+        if (resolveRowKernel(k) == k) kernels.push_back(k);
+    return kernels;
+}
+
+// Varre "rows" linhas de candidatos (copiadas de um original a cada rodada,
+// para que a entrada nao seja uma linha ja resolvida) ate somar ~cells celulas.
+template <typename Cell>
+static std::string benchScan(int cols, void (*scan)(Cell*, int), const std::vector<Cell>& expect,
+                             const std::vector<Cell>& input, int rows) {
+    std::vector<Cell> work(input.size());
+    std::memcpy(work.data(), input.data(), input.size() * sizeof(Cell));
+    for (int r = 0; r < rows; ++r) scan(work.data() + (size_t)r * cols, cols);
+    bool ok = work == expect;
+
+    long long target = 50000000, done = 0;
+    double copyMs = 0, totalMs = 0;
+    while (done < target) {
+        auto t0 = std::chrono::high_resolution_clock::now();
+        std::memcpy(work.data(), input.data(), input.size() * sizeof(Cell));
+        copyMs += msSince(t0);
+        t0 = std::chrono::high_resolution_clock::now();
+        for (int r = 0; r < rows; ++r) scan(work.data() + (size_t)r * cols, cols);
+        totalMs += msSince(t0);
+        done += (long long)rows * cols;
+    }
+    std::ostringstream out;
+    out << "\"ns_per_cell\": " << totalMs * 1e6 / done << ", \"copy_ns_per_cell\": " << copyMs * 1e6 / done
+        << ", \"matches_scalar\": " << (ok ? "true" : "false");
+    return out.str();
+}
+
+template <typename Cell>
+static void runScanCases(std::ostream& out, bool& first, int cols, uint32_t seed, const char* type,
+                         void (*(*pick)(RowKernel))(Cell*, int)) {
+    int rows = std::max(1, 65536 / cols);
+    std::mt19937 rng(seed);
+    std::vector<Cell> input((size_t)rows * cols);
+    // Candidatos parecidos com os do forestdist: valores pequenos, com
+    // degraus, para que a insercao venca em parte das colunas.
+    for (size_t i = 0; i < input.size(); ++i)
+        input[i] = (Cell)((i % cols) / 2 + rng() % 8);
+    std::vector<Cell> expect = input;
+    auto scalar = pick(RowKernel::Scalar);
+    for (int r = 0; r < rows; ++r) scalar(expect.data() + (size_t)r * cols, cols);
+
+    for (RowKernel k : availableKernels()) {
+        out << (first ? "  " : ",\n  ") << "{\"bench\": \"scan\", \"type\": \"" << type << "\", \"cols\": " << cols
+            << ", \"kernel\": \"" << rowKernelName(k) << "\", "
+            << benchScan<Cell>(cols, pick(k), expect, input, rows) << "}";
+        out.flush();
+        first = false;
+    }
+}
+
+static std::string runTed(TreeShape shape, int n, uint32_t seed, RowKernel kernel, int& distance) {
+    PostorderTree t1 = preprocessTree(makeShapeTree(shape, n, seed));
+    PostorderTree t2 = preprocessTree(makeShapeTree(shape, n, seed + 1));
+    TedStats stats;
+    TedOptions options;
+    options.rowKernel = kernel;
+    options.stats = &stats;
+    auto t0 = std::chrono::high_resolution_clock::now();
+    distance = treeEditDistance(t1, t2, options);
+    double ms = msSince(t0);
+    std::ostringstream out;
+    out << "{\"bench\": \"ted\", \"shape\": \"" << shapeName(shape) << "\", \"n\": " << n
+        << ", \"kernel\": \"" << rowKernelName(stats.rowKernel) << "\", \"dp_ms\": " << ms
+        << ", \"cells\": " << stats.cells << ", \"cells_per_sec\": " << (ms > 0 ? stats.cells / (ms / 1000.0) : 0)
+        << ", \"distance\": " << distance << "}";
+    return out.str();
+}
+
+int main(int argc, char** argv) {
+    std::vector<int> colsList = {64, 512, 4096};
+    std::vector<int> sizes = {512};
+    std::vector<TreeShape> shapes = {TreeShape::RandomParent, TreeShape::ZigZag, TreeShape::FullBinary};
+    uint32_t seed = 1;
+    std::string outPath;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--cols" && hasValue) {
+            colsList.clear();
+            for (const auto& s : split(argv[++i])) colsList.push_back(std::atoi(s.c_str()));
+        } else if (arg == "--sizes" && hasValue) {
+            sizes.clear();
+            for (const auto& s : split(argv[++i])) sizes.push_back(std::atoi(s.c_str()));
+        } else if (arg == "--shapes" && hasValue) {
+            shapes.clear();
+            for (const auto& s : split(argv[++i])) {
+                TreeShape shape;
+                if (!shapeFromName(s, shape)) {
+                    std::cerr << "Forma desconhecida: " << s << "\n";
+                    return 1;
+                }
+                shapes.push_back(shape);
+            }
+        } else if (arg == "--seed" && hasValue) {
+            seed = std::strtoul(argv[++i], nullptr, 10);
+        } else if (arg == "--out" && hasValue) {
+            outPath = argv[++i];
+        } else {
+            std::cerr << "Uso: row_kernel_bench [--cols 64,512] [--sizes 512] [--shapes random-parent] [--seed 1] [--out arquivo.json]\n";
+            return 1;
+        }
+    }
+
+    std::ofstream file;
+    if (!outPath.empty()) file.open(outPath);
+    std::ostream& out = outPath.empty() ? std::cout : file;
+
+    out << "[\n";
+    bool first = true;
+    for (int cols : colsList) {
+        runScanCases<uint16_t>(out, first, cols, seed, "uint16", rowScanKernel16);
+        runScanCases<int32_t>(out, first, cols, seed, "int32", rowScanKernel32);
+    }
+    for (TreeShape shape : shapes) {
+        for (int n : sizes) {
+            int scalarDistance = 0, autoDistance = 0;
+            out << ",\n  " << runTed(shape, n, seed, RowKernel::Scalar, scalarDistance);
+            out << ",\n  " << runTed(shape, n, seed, RowKernel::Auto, autoDistance);
+            if (scalarDistance != autoDistance)
+                std::cerr << "Distancias diferentes em " << shapeName(shape) << " n=" << n << "\n";
+            out.flush();
+        }
+    }
+    out << "\n]\n";
+    return 0;
+}
@@ -0,0 +1,159 @@
+// Benchmark do Zhang-Shasha em formas canonicas de arvore, com sementes
+// fixas. Cada caso roda em um processo filho, para que o pico de memoria
+// (ru_maxrss) seja so daquele caso. Saida em JSON, um objeto por caso, para
+// comparar versoes do algoritmo de forma objetiva.
+//
+// Uso: ted_bench [--sizes 64,128,256] [--shapes left-deep,star,...]
+//                [--seed 1] [--budget MB] [--edits k] [--out arquivo.json]
+//
+// Com --edits, T2 eh uma copia de T1 com k edicoes aleatorias (mutateTree),
+// entao a distancia esperada eh no maximo k.
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <vector>
+#include "tree_gen.h"
+
+struct BenchConfig {
+    std::vector<int> sizes = {64, 128, 256};
+    std::vector<TreeShape> shapes = {TreeShape::LeftDeep, TreeShape::RightDeep, TreeShape::FullBinary,
+                                     TreeShape::Star, TreeShape::RandomParent, TreeShape::ZigZag};
+    uint32_t seed = 1;
+    double budgetMB = 0;
+    int edits = -1; // -1: T2 eh outra arvore da mesma forma
+};
+
+static std::vector<std::string> split(const std::string& s) {
+    std::vector<std::string> parts;
+    std::stringstream ss(s);
+    std::string item;
+    while (std::getline(ss, item, ','))
+        if (!item.empty()) parts.push_back(item);
+    return parts;
+}
+
+static double msSince(std::chrono::high_resolution_clock::time_point t0) {
+    return std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - t0).count();
+}
+
+// Executa um caso e devolve os campos JSON (sem o pico de memoria).
+static std::string runCase(TreeShape shape, int n, const BenchConfig& cfg) {
+    CompactTree a = makeShapeTree(shape, n, cfg.seed);
+    CompactTree b = cfg.edits >= 0 ? mutateTree(a, cfg.edits, cfg.seed + 1)
+                                   : makeShapeTree(shape, n, cfg.seed + 1);
+
+    auto t0 = std::chrono::high_resolution_clock::now();
+    PostorderTree t1 = preprocessTree(a);
+    PostorderTree t2 = preprocessTree(b);
+    double preMs = msSince(t0);
+
+    TedStats stats;
+    TedOptions options;
+    options.memoryBudget = (size_t)(cfg.budgetMB * 1024 * 1024);
+    options.stats = &stats;
+    std::ostringstream out;
+    out << "{\"shape\": \"" << shapeName(shape) << "\", \"n\": " << n << ", \"seed\": " << cfg.seed
+        << ", \"edits\": " << cfg.edits << ", \"keyroots\": [" << t1.keyroots.size() << ", " << t2.keyroots.size() << "]"
+        << ", \"preprocess_ms\": " << preMs;
+    t0 = std::chrono::high_resolution_clock::now();
+    try {
+        int d = treeEditDistance(t1, t2, options);
+        double dpMs = msSince(t0);
+        out << ", \"dp_ms\": " << dpMs << ", \"cells\": " << stats.cells
+            << ", \"cells_per_sec\": " << (dpMs > 0 ? stats.cells / (dpMs / 1000.0) : 0)
+            << ", \"matrix_bytes\": " << stats.plan.bytes << ", \"cell_bytes\": " << stats.plan.cellBytes
+            << ", \"compact_forest\": " << (stats.plan.strategy == TedStrategy::CompactForest ? "true" : "false")
+            << ", \"distance\": " << d;
+    } catch (const std::exception& e) {
+        out << ", \"error\": \"" << e.what() << "\"";
+    }
+    return out.str();
+}
+
+// Roda o caso em um processo filho e acrescenta o pico de RSS dele.
+static std::string runIsolated(TreeShape shape, int n, const BenchConfig& cfg) {
+    int fds[2];
+    if (pipe(fds) != 0) return runCase(shape, n, cfg) + "}";
+    pid_t pid = fork();
+    if (pid < 0) {
+        close(fds[0]);
+        close(fds[1]);
+        return runCase(shape, n, cfg) + "}";
+    }
+    if (pid == 0) {
+        close(fds[0]);
+        std::string json = runCase(shape, n, cfg);
+        ssize_t written = write(fds[1], json.data(), json.size());
+        _exit(written == (ssize_t)json.size() ? 0 : 1);
+    }
+    close(fds[1]);
+    std::string json;
+    char buf[4096];
+    ssize_t got;
+    while ((got = read(fds[0], buf, sizeof buf)) > 0) json.append(buf, got);
+    close(fds[0]);
+    int status = 0;
+    struct rusage usage {};
+    wait4(pid, &status, 0, &usage);
+    if (json.empty())
+        json = std::string("{\"shape\": \"") + shapeName(shape) + "\", \"n\": " + std::to_string(n)
+             + ", \"error\": \"processo filho falhou\"";
+    return json + ", \"peak_rss_kb\": " + std::to_string(usage.ru_maxrss) + "}";
+}
+
+int main(int argc, char** argv) {
+    BenchConfig cfg;
+    std::string outPath;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--sizes" && hasValue) {
+            cfg.sizes.clear();
+            for (const auto& s : split(argv[++i])) cfg.sizes.push_back(std::atoi(s.c_str()));
+        } else if (arg == "--shapes" && hasValue) {
+            cfg.shapes.clear();
+            for (const auto& s : split(argv[++i])) {
+                TreeShape shape;
+                if (!shapeFromName(s, shape)) {
+                    std::cerr << "Forma desconhecida: " << s << "\n";
+                    return 1;
+                }
+                cfg.shapes.push_back(shape);
+            }
+        } else if (arg == "--seed" && hasValue) {
+            cfg.seed = std::strtoul(argv[++i], nullptr, 10);
+        } else if (arg == "--budget" && hasValue) {
+            cfg.budgetMB = std::atof(argv[++i]);
+        } else if (arg == "--edits" && hasValue) {
+            cfg.edits = std::atoi(argv[++i]);
+        } else if (arg == "--out" && hasValue) {
+            outPath = argv[++i];
+        } else {
+            std::cerr << "Uso: ted_bench [--sizes 64,128] [--shapes left-deep,star] [--seed 1] [--budget MB] [--edits k] [--out arquivo.json]\n";
+            return 1;
+        }
+    }
+
+    std::ofstream file;
+    if (!outPath.empty()) file.open(outPath);
+    std::ostream& out = outPath.empty() ? std::cout : file;
+
+    out << "[\n";
+    bool first = true;
+    for (TreeShape shape : cfg.shapes) {
+        for (int n : cfg.sizes) {
+            out << (first ? "  " : ",\n  ") << runIsolated(shape, n, cfg);
+            out.flush();
+            first = false;
+        }
+    }
+    out << "\n]\n";
+    return 0;
+}
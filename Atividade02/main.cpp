@@ -1,5 +1,8 @@
+#include <cstdlib>
 #include <iostream>
 #include "tree_edit.h"
+#include "tree_parse.h"
+#include "tree_trace.h"
 
 int countNodes(Node* n) {
     if (!n) return 0;
@@ -18,7 +21,41 @@ int maxDegree(Node* n) {
     return maxD;
 }
 
-int main() {
+// Compara duas arvores lidas de arquivos (colchetes, .xml ou .json), com
+// limite opcional de memoria em MB para as matrizes do algoritmo.
+static int compareFiles(const std::string& path1, const std::string& path2, double budgetMB) {
+    LabelDictionary dict;
+    PostorderTree trees[2];
+    const std::string paths[2] = {path1, path2};
+    try {
+        for (int k = 0; k < 2; ++k) {
+            ParseStats stats;
+            trees[k] = parseTreeFile(paths[k], dict, &stats);
+            std::cout << paths[k] << ": " << stats.nodes << " nos, " << stats.bytes << " bytes em "
+                      << stats.ms << " ms (" << stats.mbPerSecond << " MB/s)\n";
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Erro: " << e.what() << "\n";
+        return 1;
+    }
+    TedOptions options;
+    options.memoryBudget = (size_t)(budgetMB * 1024 * 1024);
+    TedPlan plan = planTreeEditDistance(trees[0], trees[1], options);
+    const char* names[] = {"floresta completa", "floresta compacta", "recusado"};
+    std::cout << "\nPlano de memoria: " << names[(int)plan.strategy] << ", celulas de " << plan.cellBytes
+              << " bytes, " << (plan.bytes / (1024.0 * 1024.0)) << " MB\n";
+    if (plan.strategy == TedStrategy::Refused) {
+        std::cerr << "Erro: as matrizes nao cabem no limite de " << budgetMB << " MB\n";
+        return 1;
+    }
+    int result = treeEditDistance(trees[0], trees[1], options);
+    std::cout << "\nResultado final: Distancia de edicao entre T1 e T2 = " << result << "\n";
+    return 0;
+}
+
+int main(int argc, char** argv) {
+    if (argc == 3 || argc == 4)
+        return compareFiles(argv[1], argv[2], argc == 4 ? std::atof(argv[3]) : 0);
 
     std::cout << "Algoritmo: Zhang-Shasha (Tree Edit Distance)\n";
     std::cout << "Complexidade teorica: O(n1·n2·D²), onde n1 e n2 sao os tamanhos das arvores e D eh o grau maximo\n\n";
@@ -34,7 +71,13 @@ int main() {
     // Node* T2 = generateRandomTree(3, 3, labels, minNodes);
 
     std::cout << "Iniciando calculo da distancia de edicao entre as arvores T1 e T2...\n \n";
-    int result = treeEditDistance(T1, T2, true);
+    // Rastro binario em logs/ted.trace; os logs de texto saem com
+    // ted_trace_decode logs/ted.trace logs
+    TedTrace trace;
+    int result = treeEditDistance(T1, T2, true, &trace);
+    std::cout << "\nRastro: " << trace.recorded() << " registros em logs/ted.trace"
+              << " (buffer cheio " << trace.stalls() << " vezes)\n";
+    if (!trace.ok()) std::cout << "Erro ao gravar logs/ted.trace: o rastro esta incompleto\n";
 
     //LOGS
     //int result = treeEditDistance(T1, T2, true);
@@ -48,5 +91,8 @@ int main() {
     std::cout << "\nComplexidade teorica nesta execucao: O(" << n1 << "·" << n2 << "·" << D << "²) -> O(n1·n2·D²)\n";
     std::cout << "Complexidade de espaco nesta execucao: O(" << n1 << "·" << n2 << ") -> O(n1·n2)\n";
     std::cout << "\nResultado final: Distancia de edicao entre T1 e T2 = " << result << "\n";
+
+    deleteTree(T1);
+    deleteTree(T2);
     return 0;
 }
\ No newline at end of file
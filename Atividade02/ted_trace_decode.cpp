@@ -0,0 +1,21 @@
+#include <iostream>
+#include <string>
+#include "tree_trace.h"
+
+// Gera forestdist.log e treedist.log a partir de um rastro binario gravado
+// por TedTrace.
+int main(int argc, char** argv) {
+    if (argc < 2 || argc > 3) {
+        std::cerr << "Uso: ted_trace_decode <rastro.trace> [diretorio de saida = logs]\n";
+        return 1;
+    }
+    std::string outDir = argc == 3 ? argv[2] : "logs";
+    try {
+        decodeTrace(argv[1], outDir);
+    } catch (const std::exception& e) {
+        std::cerr << "Erro: " << e.what() << "\n";
+        return 1;
+    }
+    std::cout << "Logs gravados em " << outDir << "/forestdist.log e " << outDir << "/treedist.log\n";
+    return 0;
+}
@@ -0,0 +1,53 @@
+#include "thread_pool.h"
+#include <algorithm>
+
+ThreadPool::ThreadPool(int threads) {
+    if (threads <= 0)
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    for (int i = 0; i < threads; ++i)
+        workers.emplace_back(&ThreadPool::workerLoop, this, i);
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (auto& w : workers) w.join();
+}
+
+void ThreadPool::parallelFor(size_t count, const std::function<void(size_t, int)>& body, size_t chunk) {
+    if (count == 0) return;
+    std::unique_lock<std::mutex> lock(mtx);
+    job = &body;
+    jobCount = count;
+    jobChunk = std::max<size_t>(1, chunk);
+    nextIndex = 0;
+    busy = workers.size();
+    ++generation;
+    wake.notify_all();
+    done.wait(lock, [&] { return busy == 0; });
+    job = nullptr;
+}
+
+void ThreadPool::workerLoop(int id) {
+    unsigned seen = 0;
+    std::unique_lock<std::mutex> lock(mtx);
+    while (true) {
+        wake.wait(lock, [&] { return stopping || generation != seen; });
+        if (stopping) return;
+        seen = generation;
+        while (nextIndex < jobCount) {
+            size_t begin = nextIndex;
+            size_t end = std::min(jobCount, begin + jobChunk);
+            nextIndex = end;
+            lock.unlock();
+            for (size_t i = begin; i < end; ++i)
+                (*job)(i, id);
+            lock.lock();
+        }
+        if (--busy == 0)
+            done.notify_one();
+    }
+}
@@ -0,0 +1,41 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Pool de threads fixo. As threads sao criadas uma vez e reaproveitadas em
+// cada parallelFor, que distribui os indices em blocos sob demanda.
+class ThreadPool {
+public:
+    explicit ThreadPool(int threads = 0);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    int size() const { return (int)workers.size(); }
+
+    // Executa body(i, thread) para todo i em [0, count) e espera terminar.
+    // "thread" eh o indice da thread executora em [0, size()), util para
+    // acumular resultados parciais sem sincronizacao.
+    void parallelFor(size_t count, const std::function<void(size_t, int)>& body, size_t chunk = 1);
+
+private:
+    void workerLoop(int id);
+
+    std::vector<std::thread> workers;
+    std::mutex mtx;
+    std::condition_variable wake, done;
+    const std::function<void(size_t, int)>* job = nullptr;
+    size_t jobCount = 0, jobChunk = 1, nextIndex = 0;
+    int busy = 0;
+    unsigned generation = 0;
+    bool stopping = false;
+};
+
+#endif
@@ -0,0 +1,119 @@
+#include "tree_approx.h"
+#include <algorithm>
+#include <stdexcept>
+
+static const uint64_t nullLabel = ~0ULL;
+
+static uint64_t mixLabel(uint64_t h, uint64_t v) {
+    h ^= v + 0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2);
+    h ^= h >> 31;
+    h *= 0xbf58476d1ce4e5b9ULL;
+    return h ^ (h >> 29);
+}
+
+// Primeiro filho e proximo irmao de cada no, a partir da pos-ordem: os
+// filhos de i sao i-1, lld(i-1)-1, ... enquanto >= lld(i), da direita para
+// a esquerda.
+static void childLinks(const PostorderTree& t, std::vector<int>& firstChild, std::vector<int>& nextSibling) {
+    int n = t.size();
+    firstChild.assign(n, -1);
+    nextSibling.assign(n, -1);
+    for (int i = 0; i < n; ++i) {
+        int right = -1;
+        for (int c = i - 1; c >= t.lld[i]; c = t.lld[c] - 1) {
+            nextSibling[c] = right;
+            right = c;
+        }
+        firstChild[i] = right;
+    }
+}
+
+std::vector<uint64_t> binaryBranchProfile(const PostorderTree& t) {
+    int n = t.size();
+    std::vector<int> firstChild, nextSibling;
+    childLinks(t, firstChild, nextSibling);
+    std::vector<uint64_t> branches(n);
+    for (int i = 0; i < n; ++i) {
+        uint64_t fc = firstChild[i] < 0 ? nullLabel : (uint64_t)t.labels[firstChild[i]];
+        uint64_t ns = nextSibling[i] < 0 ? nullLabel : (uint64_t)t.labels[nextSibling[i]];
+        branches[i] = mixLabel(mixLabel(mixLabel(0, t.labels[i]), fc), ns);
+    }
+    std::sort(branches.begin(), branches.end());
+    return branches;
+}
+
+std::vector<uint64_t> pqGramProfile(const PostorderTree& t, PqGramParams params) {
+    if (params.p < 1 || params.q < 1)
+        throw std::runtime_error("pq-gram: p e q devem ser positivos");
+    int n = t.size();
+    std::vector<int> firstChild, nextSibling;
+    childLinks(t, firstChild, nextSibling);
+    std::vector<int> parent(n, -1);
+    for (int i = 0; i < n; ++i)
+        for (int c = firstChild[i]; c >= 0; c = nextSibling[c]) parent[c] = i;
+
+    std::vector<uint64_t> grams;
+    grams.reserve(n + (size_t)n * (params.q - 1));
+    std::vector<uint64_t> window(params.q);
+    std::vector<int> up(params.p - 1);
+    for (int i = 0; i < n; ++i) {
+        // haste: p-1 ancestrais (do mais alto para o mais baixo) e o proprio no
+        uint64_t stem = 0;
+        for (int k = 0, a = parent[i]; k < params.p - 1; ++k) {
+            up[k] = a;
+            if (a >= 0) a = parent[a];
+        }
+        for (int k = params.p - 2; k >= 0; --k)
+            stem = mixLabel(stem, up[k] < 0 ? nullLabel : (uint64_t)t.labels[up[k]]);
+        stem = mixLabel(stem, t.labels[i]);
+
+        // base: janelas de q rotulos sobre os filhos completados com nulos
+        std::fill(window.begin(), window.end(), nullLabel);
+        if (firstChild[i] < 0) {
+            uint64_t h = stem;
+            for (uint64_t v : window) h = mixLabel(h, v);
+            grams.push_back(h);
+            continue;
+        }
+        auto emit = [&](uint64_t next) {
+            std::rotate(window.begin(), window.begin() + 1, window.end());
+            window.back() = next;
+            uint64_t h = stem;
+            for (uint64_t v : window) h = mixLabel(h, v);
+            grams.push_back(h);
+        };
+        for (int c = firstChild[i]; c >= 0; c = nextSibling[c]) emit((uint64_t)t.labels[c]);
+        for (int k = 1; k < params.q; ++k) emit(nullLabel);
+    }
+    std::sort(grams.begin(), grams.end());
+    return grams;
+}
+
+int profileIntersection(const std::vector<uint64_t>& a, const std::vector<uint64_t>& b) {
+    int common = 0;
+    size_t i = 0, j = 0;
+    while (i < a.size() && j < b.size()) {
+        if (a[i] < b[j]) ++i;
+        else if (b[j] < a[i]) ++j;
+        else { ++common; ++i; ++j; }
+    }
+    return common;
+}
+
+int profileDistance(const std::vector<uint64_t>& a, const std::vector<uint64_t>& b) {
+    return (int)(a.size() + b.size()) - 2 * profileIntersection(a, b);
+}
+
+int binaryBranchDistance(const PostorderTree& t1, const PostorderTree& t2) {
+    return profileDistance(binaryBranchProfile(t1), binaryBranchProfile(t2));
+}
+
+double pqGramDistance(const std::vector<uint64_t>& a, const std::vector<uint64_t>& b) {
+    size_t total = a.size() + b.size();
+    if (total == 0) return 0;
+    return 1.0 - 2.0 * profileIntersection(a, b) / (double)total;
+}
+
+double pqGramDistance(const PostorderTree& t1, const PostorderTree& t2, PqGramParams params) {
+    return pqGramDistance(pqGramProfile(t1, params), pqGramProfile(t2, params));
+}
@@ -0,0 +1,46 @@
+#ifndef TREE_APPROX_H
+#define TREE_APPROX_H
+
+#include "tree_edit.h"
+#include <cstdint>
+#include <vector>
+
+// Distancias aproximadas entre arvores, para ordenar ou filtrar pares antes
+// (ou no lugar) da TED exata. Cada arvore vira um perfil: um multiconjunto
+// de fragmentos codificados em 64 bits e guardados como vetor ordenado.
+// Montar o perfil custa O(n log n); comparar dois perfis eh um merge linear.
+// Os perfis podem ser calculados uma vez e reaproveitados em muitas
+// comparacoes.
+
+// Binary branches (Yang, Kalnis & Tung, 2005): na arvore binaria
+// filho-esquerdo/irmao-direito, cada no gera a tripla
+// (rotulo, rotulo do primeiro filho, rotulo do proximo irmao).
+std::vector<uint64_t> binaryBranchProfile(const PostorderTree& t);
+
+// pq-grams (Augsten, Bohlen & Gamper, 2005): para cada no, o rotulo dele e
+// de p-1 ancestrais, seguidos de q rotulos consecutivos da lista de filhos,
+// completada com q-1 nulos de cada lado (uma folha gera um unico pq-gram).
+struct PqGramParams {
+    int p = 2;
+    int q = 3;
+};
+
+std::vector<uint64_t> pqGramProfile(const PostorderTree& t, PqGramParams params = {});
+
+// Tamanho da intersecao e da diferenca simetrica de dois perfis ordenados.
+int profileIntersection(const std::vector<uint64_t>& a, const std::vector<uint64_t>& b);
+int profileDistance(const std::vector<uint64_t>& a, const std::vector<uint64_t>& b);
+
+// BDist: diferenca simetrica dos perfis de binary branches. Com custo
+// unitario, BDist <= 5 * TED; colisoes do hash so diminuem BDist, entao a
+// cota inferior continua valida.
+int binaryBranchDistance(const PostorderTree& t1, const PostorderTree& t2);
+inline int binaryBranchLowerBound(int bdist) { return (bdist + 4) / 5; }
+
+// Distancia pq-gram normalizada: 1 - 2|P1 ∩ P2| / |P1 ⊎ P2|, em [0, 1].
+// Nao eh cota da TED: aproxima a distancia de edicao ponderada pelo grau,
+// e serve para ranquear arvores por semelhanca.
+double pqGramDistance(const std::vector<uint64_t>& a, const std::vector<uint64_t>& b);
+double pqGramDistance(const PostorderTree& t1, const PostorderTree& t2, PqGramParams params = {});
+
+#endif
@@ -0,0 +1,92 @@
+#include "tree_arena.h"
+#include <utility>
+
+void CompactTree::reserve(int n) {
+    labels.reserve(n);
+    firstChild.reserve(n);
+    nextSibling.reserve(n);
+    lastChild.reserve(n);
+}
+
+int CompactTree::addNode(int label, int parent) {
+    int id = labels.size();
+    labels.push_back(label);
+    firstChild.push_back(-1);
+    nextSibling.push_back(-1);
+    lastChild.push_back(-1);
+    if (parent < 0) {
+        root = id;
+    } else {
+        if (lastChild[parent] < 0) firstChild[parent] = id;
+        else nextSibling[lastChild[parent]] = id;
+        lastChild[parent] = id;
+    }
+    return id;
+}
+
+void CompactTree::clear() {
+    std::vector<int>().swap(labels);
+    std::vector<int>().swap(firstChild);
+    std::vector<int>().swap(nextSibling);
+    std::vector<int>().swap(lastChild);
+    root = -1;
+}
+
+Node* NodeArena::make(std::string label) {
+    nodes.emplace_back(std::move(label));
+    return &nodes.back();
+}
+
+CompactTree toCompactTree(Node* root, LabelDictionary& dict) {
+    CompactTree tree;
+    if (!root) return tree;
+    // Pilha com os filhos empilhados da direita para a esquerda: cada pai
+    // recebe seus filhos na ordem original.
+    std::vector<std::pair<Node*, int>> stack = {{root, -1}};
+    while (!stack.empty()) {
+        auto [node, parent] = stack.back();
+        stack.pop_back();
+        int id = tree.addNode(dict.intern(node->label), parent);
+        for (auto it = node->children.rbegin(); it != node->children.rend(); ++it)
+            stack.push_back({*it, id});
+    }
+    return tree;
+}
+
+Node* toNodeTree(const CompactTree& tree, const LabelDictionary& dict, NodeArena& arena) {
+    if (tree.root < 0) return nullptr;
+    int n = tree.size();
+    std::vector<Node*> nodes(n);
+    for (int i = 0; i < n; ++i)
+        nodes[i] = arena.make(dict.labels[tree.labels[i]]);
+    for (int i = 0; i < n; ++i)
+        for (int c = tree.firstChild[i]; c >= 0; c = tree.nextSibling[c])
+            nodes[i]->children.push_back(nodes[c]);
+    return nodes[tree.root];
+}
+
+PostorderTree preprocessTree(const CompactTree& tree) {
+    PostorderBuilder builder;
+    if (tree.root < 0) return builder.finish();
+    builder.reserve(tree.size());
+    // A pilha do builder ja guarda os nos abertos; aqui so eh preciso saber
+    // qual no retomar depois de fechar cada um.
+    std::vector<int> stack;
+    int v = tree.root;
+    while (v >= 0) {
+        for (; v >= 0; v = tree.firstChild[v]) {
+            stack.push_back(v);
+            builder.openNode(tree.labels[v]);
+        }
+        while (!stack.empty()) {
+            int u = stack.back();
+            stack.pop_back();
+            builder.closeNode();
+            if (!stack.empty() && tree.nextSibling[u] >= 0) {
+                v = tree.nextSibling[u];
+                break;
+            }
+        }
+    }
+    return builder.finish();
+}
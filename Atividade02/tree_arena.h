@@ -0,0 +1,46 @@
+#ifndef TREE_ARENA_H
+#define TREE_ARENA_H
+
+#include "tree_edit.h"
+#include <deque>
+#include <string>
+#include <vector>
+
+// Arvore compacta: todos os nos em vetores contiguos, indexados por inteiro,
+// com filhos em primeiro-filho/proximo-irmao. Liberar a arvore inteira custa
+// poucas desalocacoes, independente do numero de nos.
+struct CompactTree {
+    std::vector<int> labels;      // id do rotulo (LabelDictionary)
+    std::vector<int> firstChild;  // -1 se folha
+    std::vector<int> nextSibling; // -1 se ultimo filho
+    std::vector<int> lastChild;   // -1 se folha; permite anexar filhos em O(1)
+    int root = -1;
+
+    int size() const { return (int)labels.size(); }
+    void reserve(int n);
+    // Cria um no e o anexa como ultimo filho de parent (-1 cria a raiz).
+    int addNode(int label, int parent = -1);
+    void clear();
+};
+
+// Arena de Node: os nos ficam em blocos contiguos e sao liberados juntos
+// quando a arena eh destruida ou limpa. Os Node* devolvidos funcionam com
+// toda a API existente (treeEditDistance, countNodes, ...), mas nao devem
+// ser passados para deleteTree.
+class NodeArena {
+public:
+    Node* make(std::string label);
+    size_t size() const { return nodes.size(); }
+    void clear() { nodes.clear(); }
+
+private:
+    std::deque<Node> nodes;
+};
+
+CompactTree toCompactTree(Node* root, LabelDictionary& dict);
+Node* toNodeTree(const CompactTree& tree, const LabelDictionary& dict, NodeArena& arena);
+
+// Pre-processamento direto da forma compacta, sem recursao nem Node*.
+PostorderTree preprocessTree(const CompactTree& tree);
+
+#endif
@@ -0,0 +1,112 @@
+#include "tree_constrained.h"
+#include <algorithm>
+#include <cstdint>
+
+namespace {
+
+// Filhos de cada no, da esquerda para a direita, em formato CSR.
+struct ChildLists {
+    std::vector<int> start; // filhos de i: list[start[i] .. start[i+1])
+    std::vector<int> list;
+    std::vector<int> size;  // tamanho da subarvore
+    int maxDegree = 0;
+
+    explicit ChildLists(const PostorderTree& t) {
+        int n = t.size();
+        start.assign(n + 1, 0);
+        size.resize(n);
+        for (int i = 0; i < n; ++i) {
+            size[i] = i - t.lld[i] + 1;
+            int degree = 0;
+            for (int c = i - 1; c >= t.lld[i]; c = t.lld[c] - 1) ++degree;
+            start[i + 1] = start[i] + degree;
+            maxDegree = std::max(maxDegree, degree);
+        }
+        list.resize(start[n]);
+        for (int i = 0; i < n; ++i) {
+            int k = start[i + 1];
+            for (int c = i - 1; c >= t.lld[i]; c = t.lld[c] - 1) list[--k] = c;
+        }
+    }
+
+    const int* begin(int i) const { return list.data() + start[i]; }
+    int degree(int i) const { return start[i + 1] - start[i]; }
+};
+
+// Distancia de edicao entre as sequencias de filhos de i e de j: apagar ou
+// inserir um filho custa o tamanho da subarvore dele; casar dois filhos custa
+// pair[filho1 * m + filho2]. E eh um rascunho de (a+1) x (b+1).
+static int alignChildren(const ChildLists& c1, int i, const ChildLists& c2, int j,
+                         const std::vector<int32_t>& pair, int m, std::vector<int32_t>& E) {
+    int a = c1.degree(i), b = c2.degree(j);
+    const int* ci = c1.begin(i);
+    const int* cj = c2.begin(j);
+    int cols = b + 1;
+    E[0] = 0;
+    for (int t = 1; t <= b; ++t) E[t] = E[t-1] + c2.size[cj[t-1]];
+    for (int s = 1; s <= a; ++s) {
+        int32_t* row = &E[(size_t)s * cols];
+        const int32_t* prev = row - cols;
+        const int32_t* pairRow = &pair[(size_t)ci[s-1] * m];
+        int del = c1.size[ci[s-1]];
+        row[0] = prev[0] + del;
+        for (int t = 1; t <= b; ++t)
+            row[t] = std::min({prev[t] + del, row[t-1] + c2.size[cj[t-1]], prev[t-1] + pairRow[cj[t-1]]});
+    }
+    return E[(size_t)a * cols + b];
+}
+
+} // namespace
+
+int constrainedEditDistance(const PostorderTree& t1, const PostorderTree& t2) {
+    int n = t1.size(), m = t2.size();
+    if (n == 0 || m == 0) return n + m;
+    ChildLists c1(t1), c2(t2);
+    // dT: arvore x arvore; dF: floresta de filhos x floresta de filhos.
+    std::vector<int32_t> dT((size_t)n * m), dF((size_t)n * m);
+    std::vector<int32_t> E((size_t)(c1.maxDegree + 1) * (c2.maxDegree + 1));
+
+    for (int i = 0; i < n; ++i) {
+        const int* ci = c1.begin(i);
+        int a = c1.degree(i);
+        int forest1 = c1.size[i] - 1;
+        for (int j = 0; j < m; ++j) {
+            const int* cj = c2.begin(j);
+            int b = c2.degree(j);
+            int forest2 = c2.size[j] - 1;
+            size_t ij = (size_t)i * m + j;
+
+            // Florestas: casar filho a filho, ou a floresta inteira de um
+            // lado dentro da floresta de um unico filho do outro.
+            int f = alignChildren(c1, i, c2, j, dT, m, E);
+            for (int t = 0; t < b; ++t)
+                f = std::min(f, forest2 + dF[(size_t)i * m + cj[t]] - (c2.size[cj[t]] - 1));
+            for (int s = 0; s < a; ++s)
+                f = std::min(f, forest1 + dF[(size_t)ci[s] * m + j] - (c1.size[ci[s]] - 1));
+            dF[ij] = f;
+
+            // Arvores: raizes casadas, ou a arvore inteira de um lado dentro
+            // de um unico filho do outro.
+            int d = f + (t1.labels[i] == t2.labels[j] ? 0 : 1);
+            for (int t = 0; t < b; ++t)
+                d = std::min(d, c2.size[j] + dT[(size_t)i * m + cj[t]] - c2.size[cj[t]]);
+            for (int s = 0; s < a; ++s)
+                d = std::min(d, c1.size[i] + dT[(size_t)ci[s] * m + j] - c1.size[ci[s]]);
+            dT[ij] = d;
+        }
+    }
+    return dT[(size_t)n * m - 1];
+}
+
+int topDownEditDistance(const PostorderTree& t1, const PostorderTree& t2) {
+    int n = t1.size(), m = t2.size();
+    if (n == 0 || m == 0) return n + m;
+    ChildLists c1(t1), c2(t2);
+    std::vector<int32_t> dist((size_t)n * m);
+    std::vector<int32_t> E((size_t)(c1.maxDegree + 1) * (c2.maxDegree + 1));
+    for (int i = 0; i < n; ++i)
+        for (int j = 0; j < m; ++j)
+            dist[(size_t)i * m + j] = alignChildren(c1, i, c2, j, dist, m, E)
+                                    + (t1.labels[i] == t2.labels[j] ? 0 : 1);
+    return dist[(size_t)n * m - 1];
+}
@@ -0,0 +1,21 @@
+#ifndef TREE_CONSTRAINED_H
+#define TREE_CONSTRAINED_H
+
+#include "tree_edit.h"
+
+// Variantes restritas da distancia de edicao, com o mesmo modelo de custo
+// unitario e as mesmas arvores pre-processadas de treeEditDistance. As duas
+// rodam em O(n * m) tempo e memoria (soma de grau(i) * grau(j) sobre todos
+// os pares), contra O(n^2 m^2) do Zhang-Shasha no pior caso. Valem
+//     TED <= constrained <= top-down.
+
+// Distancia restrita (Zhang, 1996): subarvores disjuntas de T1 so podem ser
+// mapeadas em subarvores disjuntas de T2 (mapeamento de subarvores isoladas).
+int constrainedEditDistance(const PostorderTree& t1, const PostorderTree& t2);
+
+// Distancia top-down (Selkow, 1977): as raizes sempre se correspondem e so se
+// insere ou apaga subarvores inteiras (uma folha por vez), entao um no so eh
+// mapeado se o pai dele tambem for.
+int topDownEditDistance(const PostorderTree& t1, const PostorderTree& t2);
+
+#endif
@@ -1,20 +1,17 @@
 #include "tree_edit.h"
+#include "tree_trace.h"
 #include <algorithm>
-#include <functional>
-#include <filesystem> 
 #include <iostream>
 #include <iomanip>
-#include <fstream>
 #include <chrono>
-#include <random>
+#include <functional>
 #include <queue>
-#include <set>
+#include <stdexcept>
+#include <type_traits>
 
 struct TreeInfo {
     std::vector<Node*> postorder; // pós-ordem
-    std::unordered_map<Node*, int> node2idx; // nó -> índice pós-ordem
     std::vector<int> lld; // leftmost leaf descendant para cada índice
-    std::vector<Node*> idx2node; // índice -> nó
 };
 
 static int cost(const std::string& a, const std::string& b) {
@@ -54,48 +51,300 @@ void printSideBySide(const std::vector<std::string>& left, const std::vector<std
     }
 }
 
-static void computePostorder(Node* node, TreeInfo& info) {
-    if (!node) return;
-    for (auto* child : node->children)
-        computePostorder(child, info);
-    info.node2idx[node] = info.postorder.size();
-    info.idx2node.push_back(node);
-    info.postorder.push_back(node);
+void PostorderBuilder::reserve(int n) {
+    tree.labels.reserve(n);
+    tree.lld.reserve(n);
+    tree.sizes.reserve(n);
 }
 
-static void computeLLD(Node* node, TreeInfo& info, std::unordered_map<Node*, int>& lld_map) {
-    if (!node) return;
-    if (node->children.empty()) {
-        lld_map[node] = info.node2idx[node];
-    } else {
-        computeLLD(node->children.front(), info, lld_map);
-        lld_map[node] = lld_map[node->children.front()];
+int PostorderBuilder::closeNode() {
+    auto [label, lld] = open.back();
+    open.pop_back();
+    int idx = tree.labels.size();
+    tree.labels.push_back(label);
+    tree.lld.push_back(lld);
+    tree.sizes.push_back(idx - lld + 1);
+    if (open.empty() || open.back().second != lld)
+        tree.keyroots.push_back(idx);
+    return idx;
+}
+
+PostorderTree PostorderBuilder::finish() {
+    PostorderTree out = std::move(tree);
+    tree = PostorderTree();
+    return out;
+}
+
+// Busca em profundidade com pilha explicita de (no, proximo filho): visita
+// cada no uma vez, sem recursao, e opcionalmente devolve os nos em pos-ordem.
+// Sem dicionario, os rotulos viram ids posicionais (ordem de abertura) e
+// nenhuma string eh hasheada: serve quando so lld e keyroots interessam.
+static PostorderTree walkPostorder(Node* root, LabelDictionary* dict, std::vector<Node*>* order) {
+    PostorderBuilder builder;
+    if (!root) return builder.finish();
+    int opened = 0;
+    auto labelOf = [&](Node* node) { return dict ? dict->intern(node->label) : opened++; };
+    std::vector<std::pair<Node*, size_t>> stack;
+    stack.push_back({root, 0});
+    builder.openNode(labelOf(root));
+    while (!stack.empty()) {
+        auto& [node, next] = stack.back();
+        if (next < node->children.size()) {
+            Node* child = node->children[next++];
+            stack.push_back({child, 0});
+            builder.openNode(labelOf(child));
+        } else {
+            builder.closeNode();
+            if (order) order->push_back(node);
+            stack.pop_back();
+        }
     }
-    for (auto* child : node->children)
-        computeLLD(child, info, lld_map);
+    return builder.finish();
 }
 
 static TreeInfo buildTreeInfo(Node* root) {
     TreeInfo info;
-    computePostorder(root, info);
-    info.lld.resize(info.postorder.size());
-    std::unordered_map<Node*, int> lld_map;
-    computeLLD(root, info, lld_map);
-    for (size_t i = 0; i < info.postorder.size(); ++i)
-        info.lld[i] = lld_map[info.postorder[i]];
+    info.lld = walkPostorder(root, nullptr, &info.postorder).lld;
     return info;
 }
 
-int treeEditDistance(Node* t1, Node* t2, bool showLogs) {
+int LabelDictionary::intern(const std::string& label) {
+    auto it = ids.find(label);
+    if (it != ids.end()) return it->second;
+    int id = labels.size();
+    ids.emplace(label, id);
+    labels.push_back(label);
+    return id;
+}
+
+PostorderTree preprocessTree(Node* root, LabelDictionary& dict) {
+    return walkPostorder(root, &dict, nullptr);
+}
+
+static int countLeaves(const PostorderView& t) {
+    int leaves = 0;
+    for (int i = 0; i < t.size(); ++i)
+        if (t.lld[i] == i) ++leaves;
+    return leaves;
+}
+
+TedPlan planTreeEditDistance(const PostorderView& t1, const PostorderView& t2, const TedOptions& options) {
+    TedPlan plan;
+    size_t n = t1.size(), m = t2.size();
+    // Toda celula vale no maximo n + m (apagar tudo e inserir tudo).
+    plan.cellBytes = n + m < 65535 ? sizeof(uint16_t) : sizeof(int32_t);
+    size_t tdBytes = n * m * plan.cellBytes;
+    size_t fullBytes = tdBytes + (n + 1) * (m + 1) * plan.cellBytes;
+
+    // Floresta compacta: linhas indexadas pela arvore com menos folhas.
+    size_t l1 = countLeaves(t1), l2 = countLeaves(t2);
+    plan.swapped = l2 < l1;
+    size_t rowsTree = plan.swapped ? m : n, leaves = plan.swapped ? l2 : l1;
+    size_t colsTree = plan.swapped ? n : m;
+    size_t compactBytes = tdBytes + (leaves + 2) * (colsTree + 1) * plan.cellBytes
+                        + (rowsTree + 1) * sizeof(void*);
+
+    if (options.memoryBudget == 0 || fullBytes <= options.memoryBudget) {
+        plan.strategy = TedStrategy::FullForest;
+        plan.swapped = false;
+        plan.bytes = fullBytes;
+    } else if (compactBytes <= options.memoryBudget) {
+        plan.strategy = TedStrategy::CompactForest;
+        plan.bytes = compactBytes;
+    } else {
+        plan.strategy = TedStrategy::Refused;
+        plan.bytes = compactBytes;
+    }
+    return plan;
+}
+
+namespace {
+
+// Estado do Zhang-Shasha para um tipo de celula. treedist eh um buffer unico
+// em ordem de linha (n x m). Com floresta compacta, so ficam guardadas as
+// linhas do bloco que ainda serao lidas: as de fronteira (prefixo que termina
+// logo antes de uma folha), lidas pelo caso "tree", mais duas linhas de
+// rascunho alternadas para a linha anterior e a atual. Com floresta
+// completa, o buffer cresce ate o maior bloco efetivamente calculado.
+// treedist pode ser externo (TED incremental).
+template <typename Cell>
+struct ZhangShasha {
+    PostorderView t1;
+    PostorderView t2;
+    bool compactForest;
+    int n, m;
+    std::vector<Cell> treedist;
+    Cell* td;
+    size_t tdStride; // celulas por linha de treedist (m, ou mais se externo)
+    std::vector<Cell> forestdist;
+    std::vector<Cell*> rowPtr;
+    std::vector<int> colLld;
+    void (*scan)(Cell*, int);
+    long long cells = 0;
+    // Ganchos opcionais de TedOptions; com swapped, t1 e t2 estao trocadas
+    // em relacao a quem chamou.
+    const std::function<void(int, int, int)>* onTreedist = nullptr;
+    const std::function<void(int)>* onRowDone = nullptr;
+    bool swapped = false;
+
+    ZhangShasha(const PostorderView& a, const PostorderView& b, bool compact, RowKernel kernel,
+                Cell* externalTreedist = nullptr, size_t externalStride = 0)
+        : t1(a), t2(b), compactForest(compact), n(a.size()), m(b.size()),
+          tdStride(externalTreedist ? externalStride : b.size()) {
+        if constexpr (std::is_same_v<Cell, uint16_t>) scan = rowScanKernel16(kernel);
+        else scan = rowScanKernel32(kernel);
+        if (!externalTreedist) treedist.assign((size_t)n * m, 0);
+        td = externalTreedist ? externalTreedist : treedist.data();
+        if (compact) forestdist.assign((countLeaves(t1) + 2) * (size_t)(m + 1), 0);
+        rowPtr.assign(n + 1, nullptr);
+    }
+
+    void assignRows(int i0, int rows, int cols) {
+        if (!compactForest) {
+            if (forestdist.size() < (size_t)rows * cols) forestdist.resize((size_t)rows * cols);
+            Cell* base = forestdist.data();
+            for (int r = 0; r < rows; ++r) rowPtr[r] = base + (size_t)r * cols;
+            return;
+        }
+        Cell* base = forestdist.data();
+        // Slots 0 e 1: rascunho; a partir do 2: linhas de fronteira.
+        int scratch = 0, dedicated = 2;
+        for (int r = 0; r < rows; ++r) {
+            bool boundary = r < rows - 1 && t1.lld[i0 + r] == i0 + r;
+            int slot = boundary ? dedicated++ : (scratch ^= 1);
+            rowPtr[r] = base + (size_t)slot * cols;
+        }
+    }
+
+    // Preenche o bloco forestdist do par de keyroots (k1, k2) e grava em
+    // treedist as distancias das subarvores dos caminhos mais a esquerda.
+    // Indices locais: linha r = di - lld(k1), coluna c = dj - lld(k2).
+    void forestDistance(int k1, int k2) {
+        int i0 = t1.lld[k1], j0 = t2.lld[k2];
+        int rows = k1 - i0 + 2, cols = k2 - j0 + 2;
+        assignRows(i0, rows, cols);
+        cells += (long long)(rows - 1) * (cols - 1);
+
+        Cell* first = rowPtr[0];
+        first[0] = 0;
+        for (int c = 1; c < cols; ++c)
+            first[c] = first[c-1] + 1;
+
+        // Deslocamento da folha mais a esquerda de cada coluna; 0 marca as
+        // colunas do caminho mais a esquerda de k2.
+        colLld.resize(cols);
+        for (int c = 1; c < cols; ++c)
+            colLld[c] = t2.lld[j0 + c - 1] - j0;
+        const int* lldOff = colLld.data();
+        const int* labels2 = t2.labels.data() + j0 - 1;
+
+        // Cada linha em duas fases: delecao e substituicao/"tree" dependem so
+        // de linhas anteriores; a insercao (row[c-1] + 1) vira a varredura de
+        // prefixo-minimo do kernel vetorial.
+        for (int r = 1; r < rows; ++r) {
+            int ci = i0 + r - 1;
+            int ci_lld = t1.lld[ci];
+            Cell* row = rowPtr[r];
+            const Cell* prev = rowPtr[r-1];
+            const Cell* base = rowPtr[ci_lld - i0];
+            Cell* tdRow = td + (size_t)ci * tdStride + j0 - 1;
+            row[0] = prev[0] + 1;
+            if (ci_lld == i0) {
+                int label1 = t1.labels[ci];
+                for (int c = 1; c < cols; ++c) {
+                    int c_del = prev[c] + 1;
+                    int other = lldOff[c] == 0 ? prev[c-1] + (label1 == labels2[c] ? 0 : 1)
+                                               : base[lldOff[c]] + tdRow[c];
+                    row[c] = std::min(c_del, other);
+                }
+                scan(row, cols);
+                for (int c = 1; c < cols; ++c)
+                    if (lldOff[c] == 0) {
+                        tdRow[c] = row[c];
+                        if (onTreedist) emitCell(ci, j0 + c - 1, row[c]);
+                    }
+            } else {
+                for (int c = 1; c < cols; ++c)
+                    row[c] = std::min<int>(prev[c] + 1, base[lldOff[c]] + tdRow[c]);
+                scan(row, cols);
+            }
+        }
+    }
+
+    void emitCell(int i, int j, int d) {
+        if (swapped) (*onTreedist)(j, i, d);
+        else (*onTreedist)(i, j, d);
+    }
+
+    int run() {
+        for (int k1 : t1.keyroots) {
+            for (int k2 : t2.keyroots)
+                forestDistance(k1, k2);
+            // As linhas do caminho mais a esquerda de k1 estao completas.
+            if (onRowDone && !swapped)
+                for (int i = k1; i >= t1.lld[k1]; --i)
+                    if (t1.lld[i] == t1.lld[k1]) (*onRowDone)(i);
+        }
+        if (onRowDone && swapped)
+            for (int i = 0; i < m; ++i) (*onRowDone)(i);
+        return td[(size_t)(n - 1) * tdStride + m - 1];
+    }
+
+    // Somente os pares em que algum dos keyroots esta marcado.
+    int runDirty(const std::vector<char>& dirty1, const std::vector<char>& dirty2) {
+        for (int k1 : t1.keyroots)
+            for (int k2 : t2.keyroots)
+                if (dirty1[k1] || dirty2[k2]) forestDistance(k1, k2);
+        return td[(size_t)(n - 1) * tdStride + m - 1];
+    }
+};
+
+template <typename Cell>
+int runZhangShasha(const PostorderView& t1, const PostorderView& t2, bool compact, RowKernel kernel,
+                   bool swapped, const TedOptions& options) {
+    ZhangShasha<Cell> zs(t1, t2, compact, kernel);
+    if (options.onTreedist) zs.onTreedist = &options.onTreedist;
+    if (options.onRowDone) zs.onRowDone = &options.onRowDone;
+    zs.swapped = swapped;
+    TedStats* stats = options.stats;
+    int result = zs.run();
+    if (stats) stats->cells = zs.cells;
+    return result;
+}
+
+} // namespace
+
+int treeEditDistance(const PostorderView& t1, const PostorderView& t2, const TedOptions& options) {
+    int n = t1.size();
+    int m = t2.size();
+    if (options.stats) *options.stats = TedStats();
+    if (n == 0 || m == 0) return n + m;
+
+    TedPlan plan = planTreeEditDistance(t1, t2, options);
+    if (options.stats) options.stats->plan = plan;
+    if (plan.strategy == TedStrategy::Refused)
+        throw std::runtime_error("TED precisa de " + std::to_string(plan.bytes) + " bytes, acima do limite de "
+                                 + std::to_string(options.memoryBudget) + " bytes");
+    const PostorderView& a = plan.swapped ? t2 : t1;
+    const PostorderView& b = plan.swapped ? t1 : t2;
+    bool compact = plan.strategy == TedStrategy::CompactForest;
+    RowKernel kernel = resolveRowKernel(options.rowKernel);
+    if (options.stats) options.stats->rowKernel = kernel;
+    if (plan.cellBytes == sizeof(uint16_t))
+        return runZhangShasha<uint16_t>(a, b, compact, kernel, plan.swapped, options);
+    return runZhangShasha<int32_t>(a, b, compact, kernel, plan.swapped, options);
+}
+
+long long recomputeKeyrootPairs(const PostorderView& t1, const PostorderView& t2, int32_t* treedist,
+                                size_t stride, const std::vector<char>& dirty1, const std::vector<char>& dirty2,
+                                RowKernel kernel) {
+    if (t1.size() == 0 || t2.size() == 0) return 0;
+    ZhangShasha<int32_t> zs(t1, t2, false, resolveRowKernel(kernel), treedist, stride);
+    zs.runDirty(dirty1, dirty2);
+    return zs.cells;
+}
 
-    // ARQUIVOS DE LOGS
-    std::ofstream logFileAll, logFileMain;
-    std::string logPathAll = "logs/forestdist.log";
-    std::string logPathMain = "logs/treedist.log";
-    if (!std::filesystem::exists("logs"))
-        std::filesystem::create_directory("logs");
-    logFileAll.open(logPathAll, std::ios::out | std::ios::trunc);
-    logFileMain.open(logPathMain, std::ios::out | std::ios::trunc);
+int treeEditDistance(Node* t1, Node* t2, bool showLogs, TedTrace* trace) {
 
     auto t_start = std::chrono::high_resolution_clock::now();
     int opCount = 0;
@@ -106,11 +355,9 @@ int treeEditDistance(Node* t1, Node* t2, bool showLogs) {
 
     // DP table
     std::vector<std::vector<int>> treedist(n, std::vector<int>(m, 0));
-    std::vector<std::vector<std::string>> op(n, std::vector<std::string>(m, ""));
 
     // Floresta para cada subárvore
     std::vector<std::vector<int>> forestdist(n+1, std::vector<int>(m+1, 0));
-    std::vector<std::vector<std::string>> forestop(n+1, std::vector<std::string>(m+1, ""));
 
     std::unordered_map<Node*, std::string> ids1, ids2;
     int id_counter = 1;
@@ -136,9 +383,16 @@ int treeEditDistance(Node* t1, Node* t2, bool showLogs) {
     std::cout << "\n";
 
     // --- LOGS ---
-
-    std::vector<std::vector<std::string>> last_forestop;
-    std::vector<std::vector<int>> last_forestdist;
+    // O texto so eh montado quando showLogs pede a saida no console; os
+    // arquivos vem do rastro binario (TedTrace), decodificado depois.
+
+    if (trace) {
+        std::vector<std::string> labels1, labels2;
+        for (auto* node : T1.postorder) labels1.push_back(node->label);
+        for (auto* node : T2.postorder) labels2.push_back(node->label);
+        trace->begin(labels1, labels2);
+    }
+    static const char* const chosenName[] = {"match", "substituicao", "delecao", "insercao", "tree"};
 
     for (int i = 0; i < n; ++i) {
         int i_lld = T1.lld[i];
@@ -146,24 +400,21 @@ int treeEditDistance(Node* t1, Node* t2, bool showLogs) {
             int j_lld = T2.lld[j];
 
             forestdist.assign(n+1, std::vector<int>(m+1, 0));
-            forestop.assign(n+1, std::vector<std::string>(m+1, ""));
 
             forestdist[i_lld][j_lld] = 0;
             for (int di = i_lld+1; di <= i+1; ++di) {
                 forestdist[di][j_lld] = forestdist[di-1][j_lld] + 1;
-                forestop[di][j_lld] = "del";
-                std::string logMsg = "log: forestdist[" + std::to_string(di) + "][" + std::to_string(j_lld) + "] = " +
-                    std::to_string(forestdist[di][j_lld]) + " (delecao de T1[" + T1.postorder[di-1]->label + "])\n";
-                if (showLogs) std::cout << logMsg;
-                logFileAll << logMsg;
+                if (trace) trace->record(TraceKind::InitDel, TraceOp::Del, di, j_lld, forestdist[di][j_lld]);
+                if (showLogs)
+                    std::cout << "log: forestdist[" << di << "][" << j_lld << "] = " << forestdist[di][j_lld]
+                              << " (delecao de T1[" << T1.postorder[di-1]->label << "])\n";
             }
             for (int dj = j_lld+1; dj <= j+1; ++dj) {
                 forestdist[i_lld][dj] = forestdist[i_lld][dj-1] + 1;
-                forestop[i_lld][dj] = "ins";
-                std::string logMsg = "log: forestdist[" + std::to_string(i_lld) + "][" + std::to_string(dj) + "] = " +
-                    std::to_string(forestdist[i_lld][dj]) + " (insercao de T2[" + T2.postorder[dj-1]->label + "])\n";
-                if (showLogs) std::cout << logMsg;
-                logFileAll << logMsg;
+                if (trace) trace->record(TraceKind::InitIns, TraceOp::Ins, i_lld, dj, forestdist[i_lld][dj]);
+                if (showLogs)
+                    std::cout << "log: forestdist[" << i_lld << "][" << dj << "] = " << forestdist[i_lld][dj]
+                              << " (insercao de T2[" << T2.postorder[dj-1]->label << "])\n";
             }
             for (int di = i_lld+1; di <= i+1; ++di) {
                 for (int dj = j_lld+1; dj <= j+1; ++dj) {
@@ -175,73 +426,47 @@ int treeEditDistance(Node* t1, Node* t2, bool showLogs) {
 
                         int minc = std::min({c_del, c_ins, c_sub});
                         forestdist[di][dj] = minc;
-                        std::string chosen;
-                        if (minc == c_sub) {
-                            if (T1.postorder[ci]->label == T2.postorder[cj]->label) {
-                                forestop[di][dj] = "match";
-                                chosen = "match";
-                            } else {
-                                forestop[di][dj] = "sub";
-                                chosen = "substituicao";
-                            }
-                        } else if (minc == c_del) {
-                            forestop[di][dj] = "del";
-                            chosen = "delecao";
-                        } else {
-                            forestop[di][dj] = "ins";
-                            chosen = "insercao";
-                        }
+                        TraceOp chosen;
+                        if (minc == c_sub)
+                            chosen = T1.postorder[ci]->label == T2.postorder[cj]->label ? TraceOp::Match : TraceOp::Sub;
+                        else if (minc == c_del)
+                            chosen = TraceOp::Del;
+                        else
+                            chosen = TraceOp::Ins;
                         treedist[ci][cj] = minc;
                         opCount++;
-                        op[ci][cj] = forestop[di][dj];
-
-                        // Log principal (apenas para treedist)
-                        std::string mainLogMsg = "treedist[" + std::to_string(ci) + "][" + std::to_string(cj) + "] = " + std::to_string(minc)
-                            + " | op: " + forestop[di][dj]
-                            + " (T1[" + T1.postorder[ci]->label + "] x T2[" + T2.postorder[cj]->label + "])\n";
-                        logFileMain << mainLogMsg;
-
-                        // Log detalhado (já existente)
-                        std::string logMsg = "log: forestdist[" + std::to_string(di) + "][" + std::to_string(dj) + "] = " + std::to_string(minc)
-                            + " | del: " + std::to_string(c_del) + ", ins: " + std::to_string(c_ins) + ", sub: " + std::to_string(c_sub)
-                            + " | op: " + chosen
-                            + " (T1[" + T1.postorder[ci]->label + "] x T2[" + T2.postorder[cj]->label + "])\n";
-                        if (showLogs) std::cout << logMsg;
-                        logFileAll << logMsg;
+
+                        if (trace) trace->record(TraceKind::ForestSub, chosen, di, dj, minc, c_del, c_ins, c_sub);
+                        if (showLogs)
+                            std::cout << "log: forestdist[" << di << "][" << dj << "] = " << minc
+                                      << " | del: " << c_del << ", ins: " << c_ins << ", sub: " << c_sub
+                                      << " | op: " << chosenName[(int)chosen]
+                                      << " (T1[" << T1.postorder[ci]->label << "] x T2[" << T2.postorder[cj]->label << "])\n";
                     } else {
                         int c_del = forestdist[di-1][dj] + 1;
                         int c_ins = forestdist[di][dj-1] + 1;
                         int c_sub = forestdist[T1.lld[ci]][T2.lld[cj]] + treedist[ci][cj];
                         int minc = std::min({c_del, c_ins, c_sub});
                         forestdist[di][dj] = minc;
-                        std::string chosen;
-                        if (minc == c_sub) {
-                            forestop[di][dj] = "tree";
-                            chosen = "tree";
-                        } else if (minc == c_del) {
-                            forestop[di][dj] = "del";
-                            chosen = "delecao";
-                        } else {
-                            forestop[di][dj] = "ins";
-                            chosen = "insercao";
-                        }
-                        std::string logMsg = "log: forestdist[" + std::to_string(di) + "][" + std::to_string(dj) + "] = " + std::to_string(minc)
-                            + " | del: " + std::to_string(c_del) + ", ins: " + std::to_string(c_ins) + ", tree: " + std::to_string(c_sub)
-                            + " | op: " + chosen + "\n";
-                        if (showLogs) std::cout << logMsg;
-                        logFileAll << logMsg;
+                        TraceOp chosen;
+                        if (minc == c_sub)
+                            chosen = TraceOp::Tree;
+                        else if (minc == c_del)
+                            chosen = TraceOp::Del;
+                        else
+                            chosen = TraceOp::Ins;
+                        if (trace) trace->record(TraceKind::ForestTree, chosen, di, dj, minc, c_del, c_ins, c_sub);
+                        if (showLogs)
+                            std::cout << "log: forestdist[" << di << "][" << dj << "] = " << minc
+                                      << " | del: " << c_del << ", ins: " << c_ins << ", tree: " << c_sub
+                                      << " | op: " << chosenName[(int)chosen] << "\n";
                     }
                 }
             }
-            if (i == n-1 && j == m-1) {
-                last_forestop = forestop;
-                last_forestdist = forestdist;
-            }
         }
     }
 
-    logFileAll.close();
-    logFileMain.close();
+    if (trace) trace->finish();
 
     std::cout << "\nMatriz de distancias (treedist):\n\n   |";
     for (int j = 0; j < m; ++j)
@@ -274,6 +499,16 @@ int treeEditDistance(Node* t1, Node* t2, bool showLogs) {
 
 Node::Node(std::string l) : label(std::move(l)) {}
 
+void deleteTree(Node* root) {
+    std::vector<Node*> stack;
+    if (root) stack.push_back(root);
+    while (!stack.empty()) {
+        Node* node = stack.back(); stack.pop_back();
+        for (auto* child : node->children) stack.push_back(child);
+        delete node;
+    }
+}
+
 Node* makeSampleTree1() {
     Node* A = new Node("A");
     Node* B = new Node("B");
@@ -291,97 +526,3 @@ Node* makeSampleTree2() {
     A->children = {X, C};
     return A;
 }
-
-Node* generateRandomTree(int minNodes) {
-    return generateRandomTree(-1, -1, {}, 0, minNodes);
-}
-
-Node* generateRandomTree(
-    int maxDepth,
-    int maxChildren,
-    const std::vector<std::string>& labels,
-    int currentDepth,
-    int minNodes
-) {
-    static std::mt19937 rng(std::random_device{}());
-
-    int localMaxDepth = maxDepth > 0 ? maxDepth : std::uniform_int_distribution<int>(3, 6)(rng);
-    int localMaxChildren = maxChildren > 0 ? maxChildren : std::uniform_int_distribution<int>(2, 4)(rng);
-
-    std::vector<std::string> localLabels = labels;
-    if (localLabels.empty()) {
-        int nLabels = std::uniform_int_distribution<int>(4, 10)(rng);
-        std::set<char> used;
-        while ((int)localLabels.size() < nLabels) {
-            char c = 'A' + std::uniform_int_distribution<int>(0, 25)(rng);
-            if (used.insert(c).second)
-                localLabels.push_back(std::string(1, c));
-        }
-    }
-
-    std::uniform_int_distribution<int> labelDist(0, localLabels.size() - 1);
-
-    int maxNodes = 2 * minNodes;
-
-    std::function<Node*(int, int&)> gen = [&](int depth, int& nodesLeft) -> Node* {
-        if (nodesLeft <= 0 || (localMaxDepth == 0 || depth >= localMaxDepth))
-            return nullptr;
-        Node* node = new Node(localLabels[labelDist(rng)]);
-        nodesLeft--;
-        if (nodesLeft <= 0) return node;
-        std::uniform_int_distribution<int> childDist(1, localMaxChildren);
-        int numChildren = (depth + 1 < localMaxDepth) ? std::min(childDist(rng), nodesLeft) : 0;
-        for (int i = 0; i < numChildren && nodesLeft > 0; ++i) {
-            Node* child = gen(depth + 1, nodesLeft);
-            if (child) node->children.push_back(child);
-        }
-        return node;
-    };
-
-    Node* root = nullptr;
-    int tries = 0;
-    do {
-        int nodesLeft = maxNodes;
-        if (root) delete root;
-        root = gen(0, nodesLeft);
-        ++tries;
-    } while (root && tries < 20 && [&]{
-        std::function<int(Node*)> countNodes = [&](Node* n) {
-            if (!n) return 0;
-            int cnt = 1;
-            for (auto* c : n->children) cnt += countNodes(c);
-            return cnt;
-        };
-        return countNodes(root) < minNodes;
-    }());
-
-    return root;
-}
-
-Node* generateBigTree(int minNodes) {
-    static std::mt19937 rng(std::random_device{}());
-
-    // Gera labels únicos suficientes
-    std::vector<std::string> labels;
-    for (char c = 'A'; c <= 'Z' && (int)labels.size() < minNodes; ++c)
-        labels.push_back(std::string(1, c));
-    for (int i = 0; (int)labels.size() < minNodes; ++i)
-        labels.push_back("N" + std::to_string(i));
-
-    std::shuffle(labels.begin(), labels.end(), rng);
-
-    // Cria todos os nós
-    std::vector<Node*> nodes;
-    for (int i = 0; i < minNodes; ++i)
-        nodes.push_back(new Node(labels[i]));
-
-    // Conecta os nós para formar uma árvore
-    // Cada nó (exceto a raiz) recebe um pai aleatório entre os anteriores
-    for (int i = 1; i < minNodes; ++i) {
-        std::uniform_int_distribution<int> parentDist(0, i - 1);
-        int parentIdx = parentDist(rng);
-        nodes[parentIdx]->children.push_back(nodes[i]);
-    }
-
-    return nodes[0]; // raiz
-}
\ No newline at end of file
@@ -1,9 +1,14 @@
 #ifndef TREE_EDIT_H
 #define TREE_EDIT_H
 
+#include <cstddef>
+#include <cstdint>
+#include <functional>
 #include <string>
 #include <vector>
 #include <unordered_map>
+#include <utility>
+#include "tree_simd.h"
 
 struct Node {
     std::string label;
@@ -12,7 +17,130 @@ struct Node {
     explicit Node(std::string l);
 };
 
-int treeEditDistance(Node* t1, Node* t2, bool showLogs = false);
+// Dicionario de rotulos: cada rotulo distinto recebe um id inteiro, para que
+// as arvores pre-processadas comparem inteiros em vez de strings.
+struct LabelDictionary {
+    std::unordered_map<std::string, int> ids;
+    std::vector<std::string> labels;
+
+    int intern(const std::string& label);
+};
+
+// Forma pre-processada de uma arvore, indexada em pos-ordem.
+struct PostorderTree {
+    std::vector<int> labels;   // id do rotulo de cada no
+    std::vector<int> lld;      // leftmost leaf descendant de cada no
+    std::vector<int> keyroots; // keyroots em ordem crescente
+    std::vector<int> sizes;    // tamanho da subarvore de cada no
+
+    int size() const { return (int)labels.size(); }
+};
+
+// Sequencia de inteiros somente leitura, sem posse: aponta para um vetor ou
+// para memoria mapeada.
+struct IntSpan {
+    const int* ptr = nullptr;
+    size_t count = 0;
+
+    IntSpan() = default;
+    IntSpan(const int* p, size_t n) : ptr(p), count(n) {}
+    IntSpan(const std::vector<int>& v) : ptr(v.data()), count(v.size()) {}
+
+    const int& operator[](size_t i) const { return ptr[i]; }
+    const int* data() const { return ptr; }
+    const int* begin() const { return ptr; }
+    const int* end() const { return ptr + count; }
+    size_t size() const { return count; }
+};
+
+// Visao de uma arvore pre-processada, sem copia: de uma PostorderTree (conversao
+// implicita) ou de um TreeStore mapeado em memoria (tree_store.h). Eh o que o
+// nucleo do Zhang-Shasha consome.
+struct PostorderView {
+    IntSpan labels, lld, keyroots, sizes;
+
+    PostorderView() = default;
+    PostorderView(const PostorderTree& t) : labels(t.labels), lld(t.lld), keyroots(t.keyroots), sizes(t.sizes) {}
+
+    int size() const { return (int)labels.size(); }
+};
+
+// Monta uma PostorderTree em uma unica passada, sem recursao nem hash: quem
+// percorre a arvore (com pilha explicita) chama openNode ao descer em um no e
+// closeNode ao terminar seus filhos. O lld de um no eh o indice de pos-ordem
+// corrente quando ele eh aberto; ao fecha-lo, ele eh keyroot se for a raiz ou
+// se seu lld diferir do lld do pai (ou seja, se tiver irmao a esquerda).
+struct PostorderBuilder {
+    PostorderTree tree;
+    std::vector<std::pair<int, int>> open; // (rotulo, lld) dos nos abertos
+
+    void reserve(int n);
+    void openNode(int label) { open.push_back({label, (int)tree.labels.size()}); }
+    int closeNode();     // devolve o indice de pos-ordem do no fechado
+    PostorderTree finish();
+};
+
+PostorderTree preprocessTree(Node* root, LabelDictionary& dict);
+
+class TedTrace;
+
+// Versao didatica: imprime as arvores e a matriz treedist. Com showLogs, cada
+// celula tambem eh impressa no console; com trace, cada celula vira um
+// registro binario em segundo plano (ver tree_trace.h).
+int treeEditDistance(Node* t1, Node* t2, bool showLogs = false, TedTrace* trace = nullptr);
+
+// Como o Zhang-Shasha guarda suas matrizes, escolhido antes de alocar.
+enum class TedStrategy {
+    FullForest,    // treedist n x m + bloco forestdist (n+1) x (m+1)
+    CompactForest, // treedist n x m + so as linhas de forestdist ainda lidas
+    Refused        // nao cabe no limite de memoria
+};
+
+struct TedPlan {
+    TedStrategy strategy = TedStrategy::FullForest;
+    int cellBytes = 4;    // 2 (uint16) quando n + m < 65535, senao 4
+    bool swapped = false; // linhas da floresta indexadas por T2 (menos folhas)
+    size_t bytes = 0;     // memoria estimada das matrizes
+};
+
+// Contadores de uma execucao, para benchmarks.
+struct TedStats {
+    TedPlan plan;
+    long long cells = 0; // celulas de forestdist calculadas pela recorrencia
+    RowKernel rowKernel = RowKernel::Scalar; // kernel de linha usado
+};
+
+struct TedOptions {
+    size_t memoryBudget = 0;    // bytes; 0 = sem limite
+    TedStats* stats = nullptr;  // opcional
+    RowKernel rowKernel = RowKernel::Auto; // varredura de linha (tree_simd.h)
+    // Opcionais. onTreedist recebe cada celula treedist(i, j) assim que ela
+    // fica definitiva (exatamente uma vez, com i em t1 e j em t2); onRowDone(i)
+    // avisa que todas as celulas da linha i ja foram entregues. As linhas
+    // terminam em ordem de keyroot, nao de indice.
+    std::function<void(int i, int j, int distance)> onTreedist;
+    std::function<void(int i)> onRowDone;
+};
+
+TedPlan planTreeEditDistance(const PostorderView& t1, const PostorderView& t2, const TedOptions& options = {});
+
+// Zhang-Shasha sobre arvores ja pre-processadas (mesmo dicionario de rotulos).
+// Nao imprime nada: eh o nucleo usado em lote (juncao, benchmarks). Se o
+// plano for Refused, lanca std::runtime_error antes de alocar.
+int treeEditDistance(const PostorderView& t1, const PostorderView& t2, const TedOptions& options = {});
+
+// Recalcula, sobre um treedist int32 ja preenchido (n linhas de stride >= m
+// celulas), so os pares de keyroots (k1, k2) com dirty1[k1] ou dirty2[k2]
+// (vetores indexados por no). As demais celulas precisam estar corretas.
+// Devolve o numero de celulas de forestdist calculadas. Usado pela TED
+// incremental (tree_incremental.h).
+long long recomputeKeyrootPairs(const PostorderView& t1, const PostorderView& t2, int32_t* treedist,
+                                size_t stride, const std::vector<char>& dirty1, const std::vector<char>& dirty2,
+                                RowKernel kernel = RowKernel::Auto);
+
+// Libera uma arvore alocada com new (geradores e makeSampleTree*).
+void deleteTree(Node* root);
+
 Node* makeSampleTree1();
 Node* makeSampleTree2();
 
@@ -0,0 +1,459 @@
+#include "tree_gen.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <deque>
+#include <random>
+#include <set>
+#include <stdexcept>
+
+static const char* const shapeNames[] = {
+    "left-deep", "right-deep", "full-binary", "star", "random-parent", "zig-zag"
+};
+
+const char* shapeName(TreeShape shape) {
+    return shapeNames[(int)shape];
+}
+
+bool shapeFromName(const std::string& name, TreeShape& shape) {
+    for (int i = 0; i < 6; ++i) {
+        if (name == shapeNames[i]) {
+            shape = (TreeShape)i;
+            return true;
+        }
+    }
+    return false;
+}
+
+CompactTree makeShapeTree(TreeShape shape, int n, uint32_t seed, int alphabet) {
+    CompactTree tree;
+    if (n <= 0) return tree;
+    tree.reserve(n);
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> labelDist(0, alphabet - 1);
+    auto add = [&](int parent) { return tree.addNode(labelDist(rng), parent); };
+
+    int root = add(-1);
+    switch (shape) {
+    case TreeShape::LeftDeep:
+    case TreeShape::RightDeep:
+    case TreeShape::ZigZag: {
+        int spine = root;
+        for (int level = 0; tree.size() < n; ++level) {
+            // O filho que continua a espinha eh o primeiro ou o ultimo criado.
+            bool spineFirst = shape == TreeShape::LeftDeep
+                || (shape == TreeShape::ZigZag && level % 2 == 0);
+            int a = add(spine);
+            if (tree.size() == n) break;
+            int b = add(spine);
+            spine = spineFirst ? a : b;
+        }
+        break;
+    }
+    case TreeShape::FullBinary:
+        for (int i = 1; i < n; ++i) add((i - 1) / 2);
+        break;
+    case TreeShape::Star:
+        for (int i = 1; i < n; ++i) add(root);
+        break;
+    case TreeShape::RandomParent:
+        for (int i = 1; i < n; ++i) add(std::uniform_int_distribution<int>(0, i - 1)(rng));
+        break;
+    }
+    return tree;
+}
+
+namespace {
+
+class FanoutSampler {
+public:
+    explicit FanoutSampler(const TreeGenParams& p) : params(p) {
+        if (p.fanout == FanoutDistribution::PowerLaw) {
+            std::vector<double> weights;
+            for (int k = std::max(1, p.minFanout); k <= p.maxFanout; ++k)
+                weights.push_back(std::pow((double)k, -p.exponent));
+            powerLaw = std::discrete_distribution<int>(weights.begin(), weights.end());
+        }
+    }
+
+    int draw(std::mt19937& rng) {
+        switch (params.fanout) {
+        case FanoutDistribution::Uniform:
+            return std::uniform_int_distribution<int>(params.minFanout, params.maxFanout)(rng);
+        case FanoutDistribution::Geometric:
+            return std::geometric_distribution<int>(1.0 / (1.0 + params.meanFanout))(rng);
+        case FanoutDistribution::PowerLaw:
+            return std::max(1, params.minFanout) + powerLaw(rng);
+        }
+        return 0;
+    }
+
+    // Limite de filhos por no; a geometrica nao tem limite.
+    int cap() const {
+        return params.fanout == FanoutDistribution::Geometric ? INT32_MAX : params.maxFanout;
+    }
+
+private:
+    const TreeGenParams& params;
+    std::discrete_distribution<int> powerLaw;
+};
+
+// Crescimento a partir da raiz com uma fronteira de nos ainda nao
+// expandidos. Se a fronteira esvaziar antes de N nos (graus 0 ou limite de
+// profundidade), os nos restantes vao para nos sorteados que ainda aceitam
+// filhos, o que garante exatamente N nos.
+void growTree(const TreeGenParams& p, std::mt19937& rng, CompactTree& tree) {
+    std::uniform_int_distribution<int> labelDist(0, p.alphabet - 1);
+    std::bernoulli_distribution fromBack(std::clamp(p.depthBias, 0.0, 1.0));
+    FanoutSampler fanout(p);
+    int cap = fanout.cap();
+
+    std::vector<int> depth, childCount;
+    std::deque<int> frontier;
+    std::vector<int> open; // nos que ainda aceitam filhos (limpeza preguicosa)
+    auto canHaveChildren = [&](int v) { return p.maxDepth < 0 || depth[v] < p.maxDepth; };
+    auto add = [&](int parent) {
+        int v = tree.addNode(labelDist(rng), parent);
+        depth.push_back(parent < 0 ? 0 : depth[parent] + 1);
+        childCount.push_back(0);
+        if (parent >= 0) ++childCount[parent];
+        if (canHaveChildren(v)) {
+            frontier.push_back(v);
+            open.push_back(v);
+        }
+        return v;
+    };
+
+    add(-1);
+    while (tree.size() < p.nodes) {
+        if (!frontier.empty()) {
+            int v;
+            if (fromBack(rng)) { v = frontier.back(); frontier.pop_back(); }
+            else { v = frontier.front(); frontier.pop_front(); }
+            int k = std::min(fanout.draw(rng), p.nodes - tree.size());
+            for (int c = 0; c < k; ++c) add(v);
+            continue;
+        }
+        int v = -1;
+        while (!open.empty()) {
+            size_t idx = std::uniform_int_distribution<size_t>(0, open.size() - 1)(rng);
+            if (childCount[open[idx]] < cap) { v = open[idx]; break; }
+            open[idx] = open.back();
+            open.pop_back();
+        }
+        if (v < 0)
+            throw std::invalid_argument("maxDepth/maxFanout nao comportam " + std::to_string(p.nodes) + " nos");
+        add(v);
+    }
+}
+
+// Arvore enraizada a partir de uma lista de pais (parent[0] = -1), com os
+// filhos na ordem crescente de indice.
+void buildFromParents(const std::vector<int>& parent, std::mt19937& rng, int alphabet, CompactTree& tree) {
+    int n = parent.size();
+    std::uniform_int_distribution<int> labelDist(0, alphabet - 1);
+    // Filhos em CSR, depois uma pre-ordem iterativa para criar os nos.
+    std::vector<int> start(n + 1, 0), children(std::max(0, n - 1));
+    for (int v = 1; v < n; ++v) ++start[parent[v] + 1];
+    for (int v = 0; v < n; ++v) start[v + 1] += start[v];
+    std::vector<int> fill(start.begin(), start.end() - 1);
+    for (int v = 1; v < n; ++v) children[fill[parent[v]]++] = v;
+
+    std::vector<std::pair<int, int>> stack = {{0, -1}};
+    while (!stack.empty()) {
+        auto [v, newParent] = stack.back();
+        stack.pop_back();
+        int id = tree.addNode(labelDist(rng), newParent);
+        for (int k = start[v + 1] - 1; k >= start[v]; --k)
+            stack.push_back({children[k], id});
+    }
+}
+
+// Decodificacao linear da sequencia de Pruefer; a arvore fica enraizada no
+// vertice 0 e eh devolvida como lista de pais.
+std::vector<int> prueferParents(int n, std::mt19937& rng) {
+    std::vector<int> parent(n, -1);
+    if (n <= 1) return parent;
+    std::vector<int> seq(n - 2);
+    std::uniform_int_distribution<int> vertex(0, n - 1);
+    for (auto& x : seq) x = vertex(rng);
+    std::vector<int> degree(n, 1);
+    for (int x : seq) ++degree[x];
+
+    std::vector<int> start(n + 1, 0), adj(2 * (n - 1));
+    std::vector<std::pair<int, int>> edges;
+    edges.reserve(n - 1);
+    int ptr = 0;
+    while (degree[ptr] != 1) ++ptr;
+    int leaf = ptr;
+    for (int x : seq) {
+        edges.push_back({leaf, x});
+        if (--degree[x] == 1 && x < ptr) {
+            leaf = x;
+        } else {
+            ++ptr;
+            while (degree[ptr] != 1) ++ptr;
+            leaf = ptr;
+        }
+    }
+    edges.push_back({leaf, n - 1});
+
+    for (auto [a, b] : edges) { ++start[a + 1]; ++start[b + 1]; }
+    for (int v = 0; v < n; ++v) start[v + 1] += start[v];
+    std::vector<int> fill(start.begin(), start.end() - 1);
+    for (auto [a, b] : edges) { adj[fill[a]++] = b; adj[fill[b]++] = a; }
+
+    // Orienta a partir do vertice 0 com uma busca em largura.
+    std::vector<char> seen(n, 0);
+    std::vector<int> queue = {0};
+    seen[0] = 1;
+    for (size_t head = 0; head < queue.size(); ++head) {
+        int v = queue[head];
+        for (int k = start[v]; k < start[v + 1]; ++k) {
+            int w = adj[k];
+            if (!seen[w]) {
+                seen[w] = 1;
+                parent[w] = v;
+                queue.push_back(w);
+            }
+        }
+    }
+    return parent;
+}
+
+} // namespace
+
+CompactTree generateTree(const TreeGenParams& params) {
+    CompactTree tree;
+    if (params.nodes <= 0) return tree;
+    if (params.alphabet <= 0) throw std::invalid_argument("alphabet deve ser positivo");
+    std::mt19937 rng(params.seed);
+    tree.reserve(params.nodes);
+    switch (params.model) {
+    case TreeModel::Growth:
+        growTree(params, rng, tree);
+        break;
+    case TreeModel::RandomRecursive: {
+        std::vector<int> parent(params.nodes, -1);
+        for (int v = 1; v < params.nodes; ++v)
+            parent[v] = std::uniform_int_distribution<int>(0, v - 1)(rng);
+        buildFromParents(parent, rng, params.alphabet, tree);
+        break;
+    }
+    case TreeModel::Pruefer:
+        buildFromParents(prueferParents(params.nodes, rng), rng, params.alphabet, tree);
+        break;
+    }
+    return tree;
+}
+
+CompactTree mutateTree(const CompactTree& base, int edits, uint32_t seed, int alphabet, MutationCounts* counts) {
+    CompactTree t = base;
+    int n = t.size();
+    if (n == 0) return t;
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> labelDist(0, alphabet - 1);
+    MutationCounts local;
+
+    std::vector<int> parent(n, -1);
+    for (int v = 0; v < n; ++v)
+        for (int c = t.firstChild[v]; c >= 0; c = t.nextSibling[c]) parent[c] = v;
+    std::vector<char> alive(n, 1), touched(n, 0);
+    int untouched = n;
+
+    // Sorteia um no vivo e ainda nao tocado (nao raiz, se pedido).
+    auto pick = [&](bool allowRoot) {
+        int size = t.size();
+        for (int attempt = 0; attempt < 64; ++attempt) {
+            int v = std::uniform_int_distribution<int>(0, size - 1)(rng);
+            if (alive[v] && !touched[v] && (allowRoot || v != t.root)) return v;
+        }
+        int from = std::uniform_int_distribution<int>(0, size - 1)(rng);
+        for (int k = 0; k < size; ++k) {
+            int v = (from + k) % size;
+            if (alive[v] && !touched[v] && (allowRoot || v != t.root)) return v;
+        }
+        return -1;
+    };
+    auto prevSibling = [&](int v) {
+        int prev = -1;
+        for (int c = t.firstChild[parent[v]]; c != v; c = t.nextSibling[c]) prev = c;
+        return prev;
+    };
+
+    for (int e = 0; e < edits; ++e) {
+        int op = std::uniform_int_distribution<int>(0, 2)(rng);
+        if (op == 0 && alphabet < 2) op = 2;
+        if (op == 1 && untouched <= 1) op = 2;
+        if (op == 0 || op == 1) {
+            int v = pick(op == 0);
+            if (v < 0) op = 2;
+            else if (op == 0) {
+                int label = labelDist(rng);
+                while (label == t.labels[v]) label = labelDist(rng);
+                t.labels[v] = label;
+                touched[v] = 1;
+                --untouched;
+                ++local.renames;
+            } else {
+                // Remove v: seus filhos ocupam o lugar dele no pai.
+                int p = parent[v], prev = prevSibling(v), next = t.nextSibling[v];
+                int fc = t.firstChild[v], lc = t.lastChild[v];
+                for (int c = fc; c >= 0; c = t.nextSibling[c]) parent[c] = p;
+                int headOfRest = fc >= 0 ? fc : next;
+                if (prev >= 0) t.nextSibling[prev] = headOfRest;
+                else t.firstChild[p] = headOfRest;
+                if (fc >= 0) t.nextSibling[lc] = next;
+                if (t.lastChild[p] == v) t.lastChild[p] = fc >= 0 ? lc : prev;
+                alive[v] = 0;
+                --untouched;
+                ++local.deletions;
+            }
+        }
+        if (op == 2) {
+            // Insere u sob p adotando os filhos [s, s + len) de p.
+            int p = -1;
+            for (int attempt = 0; attempt < 64 && p < 0; ++attempt) {
+                int v = std::uniform_int_distribution<int>(0, t.size() - 1)(rng);
+                if (alive[v]) p = v;
+            }
+            if (p < 0) p = t.root;
+            std::vector<int> kids;
+            for (int c = t.firstChild[p]; c >= 0; c = t.nextSibling[c]) kids.push_back(c);
+            int deg = kids.size();
+            int s = std::uniform_int_distribution<int>(0, deg)(rng);
+            int len = std::uniform_int_distribution<int>(0, deg - s)(rng);
+            int u = t.size();
+            t.labels.push_back(labelDist(rng));
+            t.firstChild.push_back(len > 0 ? kids[s] : -1);
+            t.lastChild.push_back(len > 0 ? kids[s + len - 1] : -1);
+            t.nextSibling.push_back(s + len < deg ? kids[s + len] : -1);
+            parent.push_back(p);
+            alive.push_back(1);
+            touched.push_back(1);
+            for (int k = s; k < s + len; ++k) parent[kids[k]] = u;
+            if (len > 0) t.nextSibling[kids[s + len - 1]] = -1;
+            if (s > 0) t.nextSibling[kids[s - 1]] = u;
+            else t.firstChild[p] = u;
+            if (s + len == deg) t.lastChild[p] = u;
+            ++local.insertions;
+        }
+    }
+
+    // Recompacta: pre-ordem iterativa so pelos nos ainda ligados.
+    CompactTree out;
+    out.reserve(t.size());
+    std::vector<std::pair<int, int>> stack = {{t.root, -1}};
+    std::vector<int> kids;
+    while (!stack.empty()) {
+        auto [v, newParent] = stack.back();
+        stack.pop_back();
+        int id = out.addNode(t.labels[v], newParent);
+        kids.clear();
+        for (int c = t.firstChild[v]; c >= 0; c = t.nextSibling[c]) kids.push_back(c);
+        for (auto it = kids.rbegin(); it != kids.rend(); ++it) stack.push_back({*it, id});
+    }
+    if (counts) *counts = local;
+    return out;
+}
+
+TreePair generateMutatedPair(const TreeGenParams& params, int edits) {
+    TreePair pair;
+    pair.original = generateTree(params);
+    pair.edits = edits;
+    pair.mutated = mutateTree(pair.original, edits, params.seed ^ 0x9e3779b9u, params.alphabet, &pair.counts);
+    return pair;
+}
+
+// --- Geradores da demonstracao (API com Node*) ---
+// Continuam sorteando uma arvore diferente a cada execucao, mas agora sao
+// iterativos e construidos sobre generateTree.
+
+static std::mt19937& demoRng() {
+    static std::mt19937 rng(std::random_device{}());
+    return rng;
+}
+
+static Node* toHeapNodes(const CompactTree& tree, const std::vector<std::string>& names) {
+    if (tree.root < 0) return nullptr;
+    std::vector<Node*> nodes(tree.size());
+    for (int i = 0; i < tree.size(); ++i)
+        nodes[i] = new Node(names[tree.labels[i]]);
+    for (int i = 0; i < tree.size(); ++i)
+        for (int c = tree.firstChild[i]; c >= 0; c = tree.nextSibling[c])
+            nodes[i]->children.push_back(nodes[c]);
+    return nodes[tree.root];
+}
+
+Node* generateRandomTree(int minNodes) {
+    return generateRandomTree(-1, -1, {}, 0, minNodes);
+}
+
+Node* generateRandomTree(
+    int maxDepth,
+    int maxChildren,
+    const std::vector<std::string>& labels,
+    int currentDepth,
+    int minNodes
+) {
+    std::mt19937& rng = demoRng();
+
+    int localMaxDepth = maxDepth > 0 ? maxDepth : std::uniform_int_distribution<int>(3, 6)(rng);
+    int localMaxChildren = maxChildren > 0 ? maxChildren : std::uniform_int_distribution<int>(2, 4)(rng);
+
+    std::vector<std::string> localLabels = labels;
+    if (localLabels.empty()) {
+        int nLabels = std::uniform_int_distribution<int>(4, 10)(rng);
+        std::set<char> used;
+        while ((int)localLabels.size() < nLabels) {
+            char c = 'A' + std::uniform_int_distribution<int>(0, 25)(rng);
+            if (used.insert(c).second)
+                localLabels.push_back(std::string(1, c));
+        }
+    }
+
+    // localMaxDepth niveis a partir de currentDepth, ate localMaxChildren
+    // filhos por no: o tamanho sorteado em [minNodes, 2*minNodes] eh limitado
+    // ao que cabe nesses niveis.
+    int levels = localMaxDepth - currentDepth;
+    if (levels <= 0 || minNodes <= 0) return nullptr;
+    long long capacity = 0, width = 1;
+    for (int d = 0; d < levels && capacity < 2LL * minNodes; ++d) {
+        capacity += width;
+        width *= localMaxChildren;
+    }
+
+    TreeGenParams params;
+    params.nodes = (int)std::min<long long>(capacity, std::uniform_int_distribution<int>(minNodes, 2 * minNodes)(rng));
+    params.seed = rng();
+    params.alphabet = localLabels.size();
+    params.minFanout = 1;
+    params.maxFanout = localMaxChildren;
+    params.depthBias = 0.5;
+    params.maxDepth = levels - 1;
+    return toHeapNodes(generateTree(params), localLabels);
+}
+
+Node* generateBigTree(int minNodes) {
+    if (minNodes <= 0) return nullptr;
+    std::mt19937& rng = demoRng();
+
+    // Gera labels únicos suficientes
+    std::vector<std::string> labels;
+    for (char c = 'A'; c <= 'Z' && (int)labels.size() < minNodes; ++c)
+        labels.push_back(std::string(1, c));
+    for (int i = 0; (int)labels.size() < minNodes; ++i)
+        labels.push_back("N" + std::to_string(i));
+
+    std::shuffle(labels.begin(), labels.end(), rng);
+
+    // Cada nó (exceto a raiz) recebe um pai aleatório entre os anteriores
+    TreeGenParams params;
+    params.nodes = minNodes;
+    params.seed = rng();
+    params.model = TreeModel::RandomRecursive;
+    CompactTree tree = generateTree(params);
+    for (int i = 0; i < tree.size(); ++i)
+        tree.labels[i] = i;
+    return toHeapNodes(tree, labels);
+}
@@ -0,0 +1,82 @@
+#ifndef TREE_GEN_H
+#define TREE_GEN_H
+
+#include "tree_arena.h"
+#include <cstdint>
+#include <string>
+
+// Formas canonicas para benchmarks. Todas produzem exatamente n nos; os
+// rotulos sao ids em [0, alphabet), sorteados a partir de seed.
+enum class TreeShape {
+    LeftDeep,     // espinha descendo pelo primeiro filho; cada no da espinha tem uma folha a direita
+    RightDeep,    // espelho: folha a esquerda, espinha pelo ultimo filho
+    FullBinary,   // binaria completa, preenchida por niveis
+    Star,         // raiz com n - 1 folhas
+    RandomParent, // pai de cada no sorteado entre os anteriores
+    ZigZag        // espinha alternando entre primeiro e ultimo filho
+};
+
+const char* shapeName(TreeShape shape);
+bool shapeFromName(const std::string& name, TreeShape& shape);
+
+CompactTree makeShapeTree(TreeShape shape, int n, uint32_t seed, int alphabet = 26);
+
+// Gerador aleatorio deterministico: a mesma semente gera sempre a mesma
+// arvore. Produz exatamente params.nodes nos em O(N), sem recursao, direto
+// em CompactTree.
+enum class TreeModel {
+    Growth,          // cresce a partir da raiz sorteando o grau de cada no
+    RandomRecursive, // pai de cada novo no sorteado entre os anteriores
+    Pruefer          // arvore uniforme: sequencia de Pruefer aleatoria, enraizada no vertice 0
+};
+
+enum class FanoutDistribution {
+    Uniform,   // uniforme em [minFanout, maxFanout]
+    Geometric, // geometrica com media meanFanout (graus 0, 1, 2, ...)
+    PowerLaw   // P(k) proporcional a k^-exponent em [max(1, minFanout), maxFanout]
+};
+
+struct TreeGenParams {
+    int nodes = 100;
+    uint32_t seed = 1;
+    int alphabet = 26; // rotulos em [0, alphabet)
+    TreeModel model = TreeModel::Growth;
+
+    // Somente para Growth.
+    FanoutDistribution fanout = FanoutDistribution::Uniform;
+    int minFanout = 1;
+    int maxFanout = 4;
+    double meanFanout = 2.0;
+    double exponent = 2.0;
+    // Distribuicao de profundidade: o proximo no a ser expandido sai do
+    // inicio da fronteira (crescimento por niveis, arvore rasa) ou, com
+    // probabilidade depthBias, do fim (crescimento em profundidade).
+    double depthBias = 0.0;
+    int maxDepth = -1; // profundidade maxima de um no (raiz = 0); -1 = sem limite
+};
+
+CompactTree generateTree(const TreeGenParams& params);
+
+struct MutationCounts {
+    int renames = 0;
+    int deletions = 0;
+    int insertions = 0;
+};
+
+// Copia de base com exatamente "edits" operacoes de edicao aleatorias
+// (renomear, apagar um no nao raiz promovendo seus filhos, inserir um no
+// adotando um intervalo de filhos consecutivos), cada uma sobre um no ainda
+// nao tocado. Logo TED(base, copia) <= edits.
+CompactTree mutateTree(const CompactTree& base, int edits, uint32_t seed, int alphabet = 26,
+                       MutationCounts* counts = nullptr);
+
+struct TreePair {
+    CompactTree original;
+    CompactTree mutated;
+    int edits = 0;
+    MutationCounts counts;
+};
+
+TreePair generateMutatedPair(const TreeGenParams& params, int edits);
+
+#endif
@@ -0,0 +1,193 @@
+#include "tree_incremental.h"
+#include <algorithm>
+#include <unordered_map>
+#include <utility>
+
+static uint64_t mixHash(uint64_t h, uint64_t v) {
+    h ^= v + 0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2);
+    h ^= h >> 31;
+    h *= 0xbf58476d1ce4e5b9ULL;
+    return h ^ (h >> 29);
+}
+
+std::vector<uint64_t> subtreeHashes(const PostorderTree& t) {
+    int n = t.size();
+    std::vector<uint64_t> hash(n);
+    for (int i = 0; i < n; ++i) {
+        uint64_t h = mixHash(mixHash(0, (uint64_t)t.labels[i]), (uint64_t)(i - t.lld[i]));
+        // filhos da direita para a esquerda: i-1, lld(i-1)-1, ...
+        for (int c = i - 1; c >= t.lld[i]; c = t.lld[c] - 1)
+            h = mixHash(h, hash[c]);
+        hash[i] = h;
+    }
+    return hash;
+}
+
+// As subarvores old[o] e cur[c] sao iguais? Em pos-ordem, basta comparar os
+// rotulos e as folhas mais a esquerda relativas ao inicio de cada intervalo.
+static bool sameSubtree(const PostorderTree& cur, int c, const PostorderTree& old, int o) {
+    int cs = cur.lld[c], os = old.lld[o];
+    if (c - cs != o - os) return false;
+    for (int k = 0; k <= c - cs; ++k)
+        if (cur.labels[cs + k] != old.labels[os + k] || cur.lld[cs + k] - cs != old.lld[os + k] - os)
+            return false;
+    return true;
+}
+
+// Para cada no de cur, o no de old com a mesma subarvore (ou -1). Desce da
+// raiz: quando uma subarvore inteira casa, seus descendentes casam pelo mesmo
+// deslocamento, entao cada no eh verificado no maximo uma vez. So aceita
+// copias antes do ultimo casamento e a no maximo |subarvore| posicoes do
+// deslocamento corrente: o mapa fica injetivo e crescente (remapeamento no
+// lugar) e uma folha repetida nao casa longe, descartando tudo no meio.
+static std::vector<int> matchSubtrees(const PostorderTree& cur, const std::vector<uint64_t>& curHash,
+                                      const PostorderTree& old, const std::vector<uint64_t>& oldHash) {
+    int n = cur.size();
+    std::unordered_map<uint64_t, std::vector<int>> index; // hash -> posicoes em ordem crescente
+    index.reserve(old.size());
+    for (int o = 0; o < old.size(); ++o) index[oldHash[o]].push_back(o);
+
+    std::vector<int> match(n, -1);
+    int bound = old.size();       // casamentos seguintes ficam em old[0, bound)
+    int shift = old.size() - n;   // deslocamento do ultimo casamento
+    for (int c = n - 1; c >= 0;) {
+        int found = -1;
+        auto it = index.find(curHash[c]);
+        if (it != index.end()) {
+            const std::vector<int>& at = it->second;
+            int size = c - cur.lld[c] + 1;
+            int hi = std::min(bound, c + shift + size + 1);
+            for (auto o = std::lower_bound(at.begin(), at.end(), hi); o != at.begin();) {
+                --o;
+                if (*o < c + shift - size) break;
+                if (sameSubtree(cur, c, old, *o)) {
+                    found = *o;
+                    break;
+                }
+            }
+        }
+        if (found >= 0) {
+            shift = found - c;
+            for (int k = cur.lld[c]; k <= c; ++k) match[k] = k + shift;
+            bound = old.lld[found];
+            c = cur.lld[c] - 1; // pula a subarvore inteira
+        } else {
+            --c;
+        }
+    }
+    return match;
+}
+
+static bool increasing(const std::vector<int>& map) {
+    int last = -1;
+    for (int v : map) {
+        if (v < 0) continue;
+        if (v <= last) return false;
+        last = v;
+    }
+    return true;
+}
+
+// Folga de colunas: insercoes em T2 nao obrigam a realocar a matriz.
+static size_t strideFor(int m) {
+    return (size_t)m + m / 8 + 16;
+}
+
+// Leva dist ao layout novo: a linha i recebe a linha antiga map1[i] e a
+// coluna j a coluna antiga map2[j]. Com mapas crescentes (edicoes locais) e
+// colunas dentro do stride, tudo eh feito no lugar e so as posicoes
+// deslocadas sao tocadas: primeiro as que andam para tras, em ordem
+// crescente, depois as que andam para frente, em ordem decrescente; assim
+// nenhuma origem eh sobrescrita antes de ser lida. Subarvores trocadas de
+// lugar ou falta de folga caem na copia para um buffer novo.
+void IncrementalTed::remap(const std::vector<int>& map1, const std::vector<int>& map2, int n, int m,
+                           IncrementalStats& st) {
+    if (increasing(map1) && increasing(map2) && (size_t)m <= stride) {
+        std::vector<int> back, forward;
+        for (int j = 0; j < m; ++j) {
+            if (map2[j] > j) back.push_back(j);
+            else if (map2[j] >= 0 && map2[j] < j) forward.push_back(j);
+        }
+        if (!back.empty() || !forward.empty()) {
+            for (int i = 0; i < n; ++i) {
+                if (map1[i] < 0) continue;
+                int32_t* row = &dist[(size_t)map1[i] * stride];
+                for (int j : back) row[j] = row[map2[j]];
+                for (auto it = forward.rbegin(); it != forward.rend(); ++it) row[*it] = row[map2[*it]];
+                st.movedCells += back.size() + forward.size();
+            }
+        }
+        if (dist.size() < (size_t)n * stride) dist.resize((size_t)n * stride);
+        auto moveRow = [&](int i) {
+            std::copy_n(&dist[(size_t)map1[i] * stride], m, &dist[(size_t)i * stride]);
+            st.movedCells += m - st.changed2;
+        };
+        for (int i = 0; i < n; ++i)
+            if (map1[i] > i) moveRow(i);
+        for (int i = n - 1; i >= 0; --i)
+            if (map1[i] >= 0 && map1[i] < i) moveRow(i);
+        return;
+    }
+
+    // Colunas reaproveitadas em trechos contiguos com o mesmo deslocamento:
+    // cada trecho vira uma copia de memoria por linha.
+    std::vector<std::pair<int, int>> runs; // (inicio, fim) em t2
+    for (int j = 0; j < m;) {
+        if (map2[j] < 0) { ++j; continue; }
+        int end = j + 1;
+        while (end < m && map2[end] == map2[j] + (end - j)) ++end;
+        runs.push_back({j, end});
+        j = end;
+    }
+    size_t newStride = strideFor(m);
+    std::vector<int32_t> next((size_t)n * newStride);
+    for (int i = 0; i < n; ++i) {
+        if (map1[i] < 0) continue;
+        const int32_t* from = &dist[(size_t)map1[i] * stride];
+        int32_t* to = &next[(size_t)i * newStride];
+        for (const auto& run : runs)
+            std::copy(from + map2[run.first], from + map2[run.first] + (run.second - run.first), to + run.first);
+    }
+    dist.swap(next);
+    stride = newStride;
+    st.movedCells = st.reusedCells;
+}
+
+int IncrementalTed::compare(const PostorderTree& t1, const PostorderTree& t2, IncrementalStats* stats) {
+    IncrementalStats local;
+    IncrementalStats& st = stats ? *stats : local;
+    st = IncrementalStats();
+    int n = t1.size(), m = t2.size();
+    std::vector<uint64_t> h1 = subtreeHashes(t1), h2 = subtreeHashes(t2);
+    st.keyrootPairs = (long long)t1.keyroots.size() * t2.keyroots.size();
+
+    std::vector<char> dirty1(n, 1), dirty2(m, 1);
+    if (valid) {
+        std::vector<int> map1 = matchSubtrees(t1, h1, prev1, hash1);
+        std::vector<int> map2 = matchSubtrees(t2, h2, prev2, hash2);
+        for (int i = 0; i < n; ++i) dirty1[i] = map1[i] < 0;
+        for (int j = 0; j < m; ++j) dirty2[j] = map2[j] < 0;
+        for (int i = 0; i < n; ++i) st.changed1 += dirty1[i];
+        for (int j = 0; j < m; ++j) st.changed2 += dirty2[j];
+        st.reusedCells = (long long)(n - st.changed1) * (m - st.changed2);
+        remap(map1, map2, n, m, st);
+    } else {
+        st.full = true;
+        st.changed1 = n;
+        st.changed2 = m;
+        stride = strideFor(m);
+        dist.assign((size_t)n * stride, 0);
+    }
+    for (int k1 : t1.keyroots)
+        for (int k2 : t2.keyroots)
+            if (dirty1[k1] || dirty2[k2]) ++st.recomputedPairs;
+    st.cells = recomputeKeyrootPairs(t1, t2, dist.data(), stride, dirty1, dirty2, kernel);
+
+    prev1 = t1;
+    prev2 = t2;
+    hash1 = std::move(h1);
+    hash2 = std::move(h2);
+    valid = true;
+    if (n == 0 || m == 0) return n + m;
+    return dist[(size_t)(n - 1) * stride + m - 1];
+}
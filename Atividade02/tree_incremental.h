@@ -0,0 +1,68 @@
+#ifndef TREE_INCREMENTAL_H
+#define TREE_INCREMENTAL_H
+
+#include "tree_edit.h"
+#include <cstdint>
+#include <vector>
+
+// TED incremental para versoes sucessivas de um documento. Guarda as arvores
+// da comparacao anterior e a matriz treedist. Na comparacao seguinte, cada
+// subarvore nova identica (rotulos e forma) a uma subarvore antiga do mesmo
+// lado herda a linha/coluna de treedist dela. A matriz eh atualizada no
+// lugar: so as linhas e colunas que mudaram de posicao sao deslocadas (com
+// folga de colunas para absorver insercoes). So os pares de keyroots cujo
+// caminho mais a esquerda tem algum no alterado sao recalculados.
+//
+// Limite: o ganho nao eh proporcional a regiao alterada. Um no alterado
+// marca todos os seus ancestrais, entao o keyroot da raiz sempre eh
+// recalculado, e o bloco forestdist de cada par (k1, raiz de T2) cobre T2
+// inteira. Com T2 mudando, o custo fica em
+//     sum(|T1[k1]| * |T2[k2]|) sobre os pares em que k1 ou k2 mudou
+//     >= sum(|T1[k1]|) * m,
+// ou seja, pelo menos n * m celulas. A decomposicao pelo caminho mais a
+// esquerda do Zhang-Shasha nao permite recortar esses blocos sem guardar
+// todas as tabelas forestdist; o que se economiza sao os pares em que
+// nenhum dos dois lados mudou.
+struct IncrementalStats {
+    int changed1 = 0, changed2 = 0;   // nos sem correspondente na versao anterior
+    long long keyrootPairs = 0;       // pares de keyroots da comparacao
+    long long recomputedPairs = 0;    // pares recalculados
+    long long reusedCells = 0;        // celulas de treedist mantidas da comparacao anterior
+    long long movedCells = 0;         // dessas, quantas mudaram de posicao na matriz
+    long long cells = 0;              // celulas de forestdist calculadas
+    bool full = false;                // sem estado anterior: calculo completo
+};
+
+class IncrementalTed {
+public:
+    explicit IncrementalTed(RowKernel kernel = RowKernel::Auto) : kernel(kernel) {}
+
+    // TED(t1, t2). Se ja houve uma comparacao, reaproveita o que nao mudou
+    // em relacao a ela. As arvores precisam usar o mesmo dicionario de
+    // rotulos das comparacoes anteriores.
+    int compare(const PostorderTree& t1, const PostorderTree& t2, IncrementalStats* stats = nullptr);
+
+    // Esquece o estado (a proxima comparacao eh completa).
+    void reset();
+
+    const PostorderTree& tree1() const { return prev1; }
+    const PostorderTree& tree2() const { return prev2; }
+    // treedist(i, j) da ultima comparacao.
+    int treedist(int i, int j) const { return dist[(size_t)i * stride + j]; }
+
+private:
+    RowKernel kernel;
+    bool valid = false;
+    PostorderTree prev1, prev2;
+    std::vector<uint64_t> hash1, hash2;
+    std::vector<int32_t> dist; // linhas de stride >= m celulas
+    size_t stride = 0;
+
+    void remap(const std::vector<int>& map1, const std::vector<int>& map2, int n, int m, IncrementalStats& st);
+};
+
+// Hash de cada subarvore (rotulo, tamanho e hashes dos filhos em ordem),
+// indexado pela pos-ordem.
+std::vector<uint64_t> subtreeHashes(const PostorderTree& t);
+
+#endif
@@ -0,0 +1,227 @@
+#include "tree_index.h"
+#include "thread_pool.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <limits>
+#include <queue>
+#include <random>
+#include <stdexcept>
+
+static const char indexMagic[8] = {'T', 'E', 'D', 'V', 'P', 'I', 'D', 'X'};
+static const uint32_t indexVersion = 1;
+
+static bool byDistance(const IndexMatch& a, const IndexMatch& b) {
+    return a.distance != b.distance ? a.distance < b.distance : a.id < b.id;
+}
+
+// Impressao digital da colecao: tamanhos, rotulos e lld de todas as arvores.
+static uint64_t fingerprint(const std::vector<PostorderTree>& trees) {
+    uint64_t h = 1469598103934665603ULL;
+    auto mix = [&](uint64_t v) { h = (h ^ v) * 1099511628211ULL; };
+    mix(trees.size());
+    for (const auto& t : trees) {
+        mix(t.size());
+        for (int i = 0; i < t.size(); ++i) {
+            mix((uint64_t)t.labels[i]);
+            mix((uint64_t)t.lld[i]);
+        }
+    }
+    return h;
+}
+
+void VpTreeIndex::build(const std::vector<PostorderTree>& collection, int threads, uint32_t seed,
+                        IndexBuildStats* stats) {
+    auto t0 = std::chrono::high_resolution_clock::now();
+    trees = &collection;
+    nodes.clear();
+    int n = collection.size();
+    if (stats) *stats = IndexBuildStats();
+    if (n == 0) return;
+
+    // items[begin, end) de cada segmento vira a subarvore do vertice "node".
+    struct Segment {
+        int node, begin, end;
+    };
+    std::vector<int> items(n);
+    std::vector<int> dist(n);
+    for (int i = 0; i < n; ++i) items[i] = i;
+    std::mt19937 rng(seed);
+    ThreadPool pool(threads);
+
+    nodes.push_back({-1, 0, -1, -1});
+    std::vector<Segment> level = {{0, 0, n}}, next;
+    std::vector<int> offset; // inicio das tarefas de cada segmento no nivel
+    long long evaluations = 0;
+    while (!level.empty()) {
+        offset.assign(1, 0);
+        for (const Segment& s : level) {
+            std::swap(items[s.begin], items[s.begin + std::uniform_int_distribution<int>(0, s.end - s.begin - 1)(rng)]);
+            nodes[s.node].item = items[s.begin];
+            offset.push_back(offset.back() + (s.end - s.begin - 1));
+        }
+        // Distancias de todos os pontos do nivel aos seus pontos de vantagem.
+        pool.parallelFor(offset.back(), [&](size_t task, int) {
+            int seg = std::upper_bound(offset.begin(), offset.end(), (int)task) - offset.begin() - 1;
+            const Segment& s = level[seg];
+            int pos = s.begin + 1 + ((int)task - offset[seg]);
+            dist[pos] = treeEditDistance(collection[items[s.begin]], collection[items[pos]]);
+        }, 4);
+        evaluations += offset.back();
+
+        next.clear();
+        for (const Segment& s : level) {
+            int first = s.begin + 1, count = s.end - first;
+            if (count == 0) continue;
+            std::vector<std::pair<int, int>> order(count);
+            for (int k = 0; k < count; ++k) order[k] = {dist[first + k], items[first + k]};
+            std::sort(order.begin(), order.end());
+            int mu = order[(count - 1) / 2].first;
+            int split = std::upper_bound(order.begin(), order.end(), std::make_pair(mu, n)) - order.begin();
+            for (int k = 0; k < count; ++k) items[first + k] = order[k].second;
+            nodes[s.node].mu = mu;
+            // nodes pode realocar: so indices sao guardados entre iteracoes
+            if (split > 0) {
+                nodes[s.node].inside = nodes.size();
+                next.push_back({(int)nodes.size(), first, first + split});
+                nodes.push_back({-1, 0, -1, -1});
+            }
+            if (split < count) {
+                nodes[s.node].outside = nodes.size();
+                next.push_back({(int)nodes.size(), first + split, s.end});
+                nodes.push_back({-1, 0, -1, -1});
+            }
+        }
+        level.swap(next);
+    }
+    if (stats) {
+        stats->tedEvaluations = evaluations;
+        stats->ms = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - t0).count();
+    }
+}
+
+// Busca do melhor primeiro: a fila ordena os vertices pela cota inferior da
+// distancia de qualquer ponto da subarvore ate a consulta. visit(id, d)
+// recebe cada ponto de vantagem avaliado e devolve o raio atual (com
+// id = -1, so o raio inicial); a busca para quando a menor cota passa do raio.
+template <typename Visit>
+void VpTreeIndex::search(const PostorderTree& query, IndexQueryStats& stats, Visit visit) const {
+    if (nodes.empty()) return;
+    using Entry = std::pair<int, int>; // (cota inferior, vertice)
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> queue;
+    queue.push({0, 0});
+    int radius = visit(-1, 0);
+    while (!queue.empty()) {
+        auto [bound, v] = queue.top();
+        queue.pop();
+        if (bound > radius) break;
+        const VpNode& node = nodes[v];
+        ++stats.nodesVisited;
+        ++stats.tedEvaluations;
+        int d = treeEditDistance(query, (*trees)[node.item]);
+        radius = visit(node.item, d);
+        // dentro: d(x, vp) <= mu, logo d(q, x) >= d - mu
+        // fora:   d(x, vp) >= mu + 1, logo d(q, x) >= mu + 1 - d
+        if (node.inside >= 0) {
+            int lb = std::max(bound, d - node.mu);
+            if (lb <= radius) queue.push({lb, node.inside});
+        }
+        if (node.outside >= 0) {
+            int lb = std::max(bound, node.mu + 1 - d);
+            if (lb <= radius) queue.push({lb, node.outside});
+        }
+    }
+}
+
+std::vector<IndexMatch> VpTreeIndex::knn(const PostorderTree& query, int k, IndexQueryStats* stats) const {
+    IndexQueryStats local;
+    IndexQueryStats& st = stats ? *stats : local;
+    st = IndexQueryStats();
+    std::vector<IndexMatch> best; // heap maximo por (distancia, id)
+    if (k <= 0) return best;
+    search(query, st, [&](int id, int d) {
+        if (id >= 0) {
+            IndexMatch m{id, d};
+            if ((int)best.size() < k) {
+                best.push_back(m);
+                std::push_heap(best.begin(), best.end(), byDistance);
+            } else if (byDistance(m, best.front())) {
+                std::pop_heap(best.begin(), best.end(), byDistance);
+                best.back() = m;
+                std::push_heap(best.begin(), best.end(), byDistance);
+            }
+        }
+        return (int)best.size() < k ? std::numeric_limits<int>::max() : best.front().distance;
+    });
+    std::sort(best.begin(), best.end(), byDistance);
+    return best;
+}
+
+std::vector<IndexMatch> VpTreeIndex::range(const PostorderTree& query, int radius, IndexQueryStats* stats) const {
+    IndexQueryStats local;
+    IndexQueryStats& st = stats ? *stats : local;
+    st = IndexQueryStats();
+    std::vector<IndexMatch> found;
+    search(query, st, [&](int id, int d) {
+        if (id >= 0 && d <= radius) found.push_back({id, d});
+        return radius;
+    });
+    std::sort(found.begin(), found.end(), byDistance);
+    return found;
+}
+
+void VpTreeIndex::save(const std::string& path) const {
+    if (!trees) throw std::runtime_error("indice vazio: chame build antes de save");
+    std::FILE* f = std::fopen(path.c_str(), "wb");
+    if (!f) throw std::runtime_error("nao foi possivel criar " + path);
+    uint32_t count = trees->size(), nodeCount = nodes.size();
+    uint64_t fp = fingerprint(*trees);
+    std::fwrite(indexMagic, 1, sizeof indexMagic, f);
+    std::fwrite(&indexVersion, sizeof indexVersion, 1, f);
+    std::fwrite(&count, sizeof count, 1, f);
+    std::fwrite(&nodeCount, sizeof nodeCount, 1, f);
+    std::fwrite(&fp, sizeof fp, 1, f);
+    std::fwrite(nodes.data(), sizeof(VpNode), nodes.size(), f);
+    bool ok = std::ferror(f) == 0;
+    if (std::fclose(f) != 0 || !ok) throw std::runtime_error("erro ao gravar " + path);
+}
+
+void VpTreeIndex::load(const std::string& path, const std::vector<PostorderTree>& collection) {
+    std::FILE* f = std::fopen(path.c_str(), "rb");
+    if (!f) throw std::runtime_error("nao foi possivel abrir " + path);
+    char magic[8];
+    uint32_t version = 0, count = 0, nodeCount = 0;
+    uint64_t fp = 0;
+    bool ok = std::fread(magic, 1, sizeof magic, f) == sizeof magic && std::equal(magic, magic + 8, indexMagic)
+           && std::fread(&version, sizeof version, 1, f) == 1 && version == indexVersion
+           && std::fread(&count, sizeof count, 1, f) == 1 && std::fread(&nodeCount, sizeof nodeCount, 1, f) == 1
+           && std::fread(&fp, sizeof fp, 1, f) == 1;
+    std::vector<VpNode> loaded;
+    if (ok) {
+        loaded.resize(nodeCount);
+        ok = std::fread(loaded.data(), sizeof(VpNode), nodeCount, f) == nodeCount;
+    }
+    std::fclose(f);
+    if (!ok) throw std::runtime_error(path + ": arquivo de indice invalido");
+    if (count != collection.size() || fp != fingerprint(collection))
+        throw std::runtime_error(path + ": o indice foi construido sobre outra colecao");
+    // Filhos sempre depois do pai: garante que a busca termina.
+    auto validChild = [&](int32_t child, int32_t parent) {
+        return child == -1 || (child > parent && child < (int32_t)nodeCount);
+    };
+    for (int32_t v = 0; v < (int32_t)nodeCount; ++v) {
+        const VpNode& node = loaded[v];
+        if (node.item < 0 || node.item >= (int32_t)count || !validChild(node.inside, v) || !validChild(node.outside, v))
+            throw std::runtime_error(path + ": arquivo de indice invalido");
+    }
+    nodes = std::move(loaded);
+    trees = &collection;
+}
+
+std::vector<IndexMatch> linearKnn(const std::vector<PostorderTree>& trees, const PostorderTree& query, int k) {
+    std::vector<IndexMatch> all(trees.size());
+    for (size_t i = 0; i < trees.size(); ++i) all[i] = {(int)i, treeEditDistance(query, trees[i])};
+    std::sort(all.begin(), all.end(), byDistance);
+    if ((int)all.size() > k) all.resize(std::max(k, 0));
+    return all;
+}
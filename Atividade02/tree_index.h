@@ -0,0 +1,71 @@
+#ifndef TREE_INDEX_H
+#define TREE_INDEX_H
+
+#include "tree_edit.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Indice metrico (VP-tree) sobre uma colecao de arvores pre-processadas. A
+// TED eh uma metrica, entao cada vertice do indice guarda um ponto de
+// vantagem e a mediana mu das distancias dele aos pontos da subarvore:
+// dentro ficam os de distancia <= mu, fora os de distancia > mu. Pela
+// desigualdade triangular, uma consulta q com d(q, vp) = d so precisa
+// descer no lado de dentro se d - raio <= mu, e no de fora se d + raio > mu.
+
+struct IndexMatch {
+    int id;       // posicao na colecao indexada
+    int distance;
+};
+
+struct IndexQueryStats {
+    long long tedEvaluations = 0; // chamadas de treeEditDistance
+    long long nodesVisited = 0;
+};
+
+struct IndexBuildStats {
+    long long tedEvaluations = 0;
+    double ms = 0;
+};
+
+class VpTreeIndex {
+public:
+    // Indexa trees. A colecao precisa continuar viva (e inalterada) enquanto
+    // o indice for usado. A construcao eh por niveis: as distancias de todos
+    // os vertices de um nivel aos seus pontos de vantagem sao calculadas em
+    // paralelo. threads = 0 usa std::thread::hardware_concurrency().
+    void build(const std::vector<PostorderTree>& trees, int threads = 0, uint32_t seed = 1,
+               IndexBuildStats* stats = nullptr);
+
+    // Os k vizinhos mais proximos de query, por (distancia, id).
+    std::vector<IndexMatch> knn(const PostorderTree& query, int k, IndexQueryStats* stats = nullptr) const;
+
+    // Todas as arvores com TED <= radius, por (distancia, id).
+    std::vector<IndexMatch> range(const PostorderTree& query, int radius, IndexQueryStats* stats = nullptr) const;
+
+    // Grava so a estrutura do indice, com uma impressao digital da colecao;
+    // load confere que a colecao passada eh a mesma (lanca std::runtime_error).
+    void save(const std::string& path) const;
+    void load(const std::string& path, const std::vector<PostorderTree>& trees);
+
+    int size() const { return (int)nodes.size(); }
+
+private:
+    struct VpNode {
+        int32_t item;
+        int32_t mu;
+        int32_t inside;  // -1 se vazio
+        int32_t outside; // -1 se vazio
+    };
+
+    template <typename Visit>
+    void search(const PostorderTree& query, IndexQueryStats& stats, Visit visit) const;
+
+    const std::vector<PostorderTree>* trees = nullptr;
+    std::vector<VpNode> nodes;
+};
+
+// Brute force para comparacao: TED de query contra todas as arvores.
+std::vector<IndexMatch> linearKnn(const std::vector<PostorderTree>& trees, const PostorderTree& query, int k);
+
+#endif
@@ -0,0 +1,159 @@
+#include "tree_join.h"
+#include "thread_pool.h"
+#include "tree_approx.h"
+#include "tree_parse.h"
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <stdexcept>
+
+void TreeCorpus::add(PostorderTree tree) {
+    CorpusTree entry;
+    std::vector<int> sorted = tree.labels;
+    std::sort(sorted.begin(), sorted.end());
+    for (size_t i = 0; i < sorted.size();) {
+        size_t j = i;
+        while (j < sorted.size() && sorted[j] == sorted[i]) ++j;
+        entry.labelHistogram.push_back({sorted[i], (int)(j - i)});
+        i = j;
+    }
+    entry.branches = binaryBranchProfile(tree);
+    entry.tree = std::move(tree);
+    trees.push_back(std::move(entry));
+}
+
+TreeCorpus loadCorpus(const std::string& path, LabelDictionary& dict) {
+    MappedFile file(path);
+    TreeCorpus corpus;
+    try {
+        parseBracketForest(file.data(), file.size(), dict, [&](PostorderTree&& tree) {
+            corpus.add(std::move(tree));
+        });
+    } catch (const std::runtime_error& e) {
+        throw std::runtime_error(path + ": " + e.what());
+    }
+    return corpus;
+}
+
+// Cota inferior da TED pelos histogramas: cada operacao altera no maximo um
+// rotulo de cada lado, logo TED >= max(|A - B|, |B - A|) (multiconjuntos).
+static int histogramBound(const CorpusTree& a, const CorpusTree& b) {
+    int onlyA = 0, onlyB = 0;
+    size_t i = 0, j = 0;
+    const auto& ha = a.labelHistogram;
+    const auto& hb = b.labelHistogram;
+    while (i < ha.size() && j < hb.size()) {
+        if (ha[i].first < hb[j].first) onlyA += ha[i++].second;
+        else if (hb[j].first < ha[i].first) onlyB += hb[j++].second;
+        else {
+            int diff = ha[i].second - hb[j].second;
+            if (diff > 0) onlyA += diff; else onlyB -= diff;
+            ++i; ++j;
+        }
+    }
+    for (; i < ha.size(); ++i) onlyA += ha[i].second;
+    for (; j < hb.size(); ++j) onlyB += hb[j].second;
+    return std::max(onlyA, onlyB);
+}
+
+static std::vector<JoinPair> runJoin(const TreeCorpus& left, const TreeCorpus& right, bool self, int tau,
+                                     JoinStats& stats, const JoinOptions& options) {
+    stats = JoinStats();
+    long long nl = left.size(), nr = right.size();
+    stats.totalPairs = self ? nl * (nl - 1) / 2 : nl * nr;
+
+    ThreadPool pool(options.threads);
+    int threads = pool.size();
+
+    // Indice por tamanho: o filtro de tamanho vira uma busca binaria.
+    std::vector<int> bySize(nr);
+    for (int j = 0; j < nr; ++j) bySize[j] = j;
+    std::sort(bySize.begin(), bySize.end(), [&](int a, int b) {
+        return right.trees[a].tree.size() < right.trees[b].tree.size();
+    });
+    std::vector<int> sortedSizes(nr);
+    for (int j = 0; j < nr; ++j) sortedSizes[j] = right.trees[bySize[j]].tree.size();
+
+    struct Counters { long long size = 0, histogram = 0, binaryBranch = 0; };
+    std::vector<Counters> counters(threads);
+    std::vector<std::vector<std::pair<int, int>>> candidates(threads);
+
+    auto t0 = std::chrono::high_resolution_clock::now();
+    pool.parallelFor(nl, [&](size_t li, int tid) {
+        const CorpusTree& a = left.trees[li];
+        int n = a.tree.size();
+        size_t begin = 0, end = nr;
+        if (options.sizeFilter) {
+            begin = std::lower_bound(sortedSizes.begin(), sortedSizes.end(), n - tau) - sortedSizes.begin();
+            end = std::upper_bound(sortedSizes.begin(), sortedSizes.end(), n + tau) - sortedSizes.begin();
+        }
+        Counters& cnt = counters[tid];
+        for (size_t k = begin; k < end; ++k) {
+            int rj = bySize[k];
+            if (self && rj <= (int)li) continue;
+            ++cnt.size;
+            const CorpusTree& b = right.trees[rj];
+            if (options.histogramFilter && histogramBound(a, b) > tau) continue;
+            ++cnt.histogram;
+            if (options.binaryBranchFilter && binaryBranchLowerBound(profileDistance(a.branches, b.branches)) > tau) continue;
+            ++cnt.binaryBranch;
+            candidates[tid].push_back({(int)li, rj});
+        }
+    }, 16);
+    auto t1 = std::chrono::high_resolution_clock::now();
+
+    std::vector<std::pair<int, int>> all;
+    for (auto& c : candidates) {
+        all.insert(all.end(), c.begin(), c.end());
+        std::vector<std::pair<int, int>>().swap(c);
+    }
+    for (const auto& c : counters) {
+        stats.afterSize += c.size;
+        stats.afterHistogram += c.histogram;
+        stats.afterBinaryBranch += c.binaryBranch;
+    }
+
+    std::vector<std::vector<JoinPair>> found(threads);
+    pool.parallelFor(all.size(), [&](size_t k, int tid) {
+        auto [li, rj] = all[k];
+        int d = treeEditDistance(left.trees[li].tree, right.trees[rj].tree);
+        if (d <= tau) found[tid].push_back({li, rj, d});
+    }, 8);
+    auto t2 = std::chrono::high_resolution_clock::now();
+
+    std::vector<JoinPair> result;
+    for (auto& f : found) result.insert(result.end(), f.begin(), f.end());
+    std::sort(result.begin(), result.end(), [](const JoinPair& a, const JoinPair& b) {
+        return a.left != b.left ? a.left < b.left : a.right < b.right;
+    });
+
+    stats.results = result.size();
+    stats.filterMs = std::chrono::duration<double, std::milli>(t1 - t0).count();
+    stats.verifyMs = std::chrono::duration<double, std::milli>(t2 - t1).count();
+    stats.verifiedPerSecond = stats.verifyMs > 0 ? all.size() / (stats.verifyMs / 1000.0) : 0;
+    return result;
+}
+
+std::vector<JoinPair> similarityJoin(const TreeCorpus& left, const TreeCorpus& right, int tau,
+                                     JoinStats& stats, const JoinOptions& options) {
+    return runJoin(left, right, false, tau, stats, options);
+}
+
+std::vector<JoinPair> similarityJoin(const TreeCorpus& corpus, int tau,
+                                     JoinStats& stats, const JoinOptions& options) {
+    return runJoin(corpus, corpus, true, tau, stats, options);
+}
+
+void printJoinStats(const JoinStats& stats) {
+    auto pct = [&](long long v) {
+        return stats.totalPairs ? 100.0 * v / stats.totalPairs : 0.0;
+    };
+    std::cout << "Pares possiveis:            " << stats.totalPairs << "\n";
+    std::cout << "Apos filtro de tamanho:     " << stats.afterSize << " (" << pct(stats.afterSize) << "%)\n";
+    std::cout << "Apos filtro de histograma:  " << stats.afterHistogram << " (" << pct(stats.afterHistogram) << "%)\n";
+    std::cout << "Apos filtro binary-branch:  " << stats.afterBinaryBranch << " (" << pct(stats.afterBinaryBranch) << "%)\n";
+    std::cout << "Pares dentro do limiar:     " << stats.results << "\n";
+    std::cout << "Tempo de filtragem:         " << stats.filterMs << " ms\n";
+    std::cout << "Tempo de verificacao (TED): " << stats.verifyMs << " ms\n";
+    std::cout << "Vazao da verificacao:       " << stats.verifiedPerSecond << " pares/s\n";
+}
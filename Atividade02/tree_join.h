@@ -0,0 +1,66 @@
+#ifndef TREE_JOIN_H
+#define TREE_JOIN_H
+
+#include "tree_edit.h"
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Arvore do corpus com as assinaturas usadas pelos filtros da juncao.
+// Tudo eh calculado uma unica vez, ao inserir a arvore no corpus.
+struct CorpusTree {
+    PostorderTree tree;
+    std::vector<std::pair<int, int>> labelHistogram; // (id do rotulo, ocorrencias), ordenado por id
+    std::vector<uint64_t> branches;                  // perfil de binary branches (tree_approx.h)
+};
+
+struct TreeCorpus {
+    std::vector<CorpusTree> trees;
+
+    void add(PostorderTree tree);
+    int size() const { return (int)trees.size(); }
+};
+
+// Le um corpus em notacao de colchetes, uma arvore por linha: {A{B}{C}}.
+// O arquivo eh mapeado em memoria e lido em uma passada (parseBracketForest). Todos os corpora comparados entre si devem
+// compartilhar o mesmo dicionario de rotulos.
+TreeCorpus loadCorpus(const std::string& path, LabelDictionary& dict);
+
+struct JoinOptions {
+    int threads = 0;                // 0 = std::thread::hardware_concurrency()
+    bool sizeFilter = true;         // |n1 - n2| <= tau
+    bool histogramFilter = true;    // diferenca de multiconjuntos de rotulos <= tau
+    bool binaryBranchFilter = true; // perfil de binary branches: BDist <= 5*tau
+};
+
+struct JoinPair {
+    int left;
+    int right;
+    int distance;
+};
+
+// Efetividade dos filtros e vazao. Cada contador eh o numero de pares que
+// sobreviveram ate aquela etapa.
+struct JoinStats {
+    long long totalPairs = 0;
+    long long afterSize = 0;
+    long long afterHistogram = 0;
+    long long afterBinaryBranch = 0;
+    long long results = 0;
+    double filterMs = 0;
+    double verifyMs = 0;
+    double verifiedPerSecond = 0;
+};
+
+// Todos os pares (i, j), i de left e j de right, com TED <= tau.
+std::vector<JoinPair> similarityJoin(const TreeCorpus& left, const TreeCorpus& right, int tau,
+                                     JoinStats& stats, const JoinOptions& options = {});
+
+// Auto-juncao: todos os pares i < j do corpus com TED <= tau.
+std::vector<JoinPair> similarityJoin(const TreeCorpus& corpus, int tau,
+                                     JoinStats& stats, const JoinOptions& options = {});
+
+void printJoinStats(const JoinStats& stats);
+
+#endif
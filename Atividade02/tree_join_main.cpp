@@ -0,0 +1,59 @@
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include "tree_join.h"
+
+static void usage() {
+    std::cerr << "Uso: tree_join <corpus.txt> <limiar> [--queries arquivo.txt] [--threads N] [--quiet]\n"
+              << "  corpus e consultas: uma arvore por linha em notacao de colchetes, ex.: {A{B}{C}}\n"
+              << "  sem --queries, faz a auto-juncao do corpus (pares i < j)\n";
+}
+
+int main(int argc, char** argv) {
+    if (argc < 3) {
+        usage();
+        return 1;
+    }
+    std::string corpusPath = argv[1];
+    int tau = std::atoi(argv[2]);
+    std::string queriesPath;
+    JoinOptions options;
+    bool quiet = false;
+    for (int i = 3; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--queries" && i + 1 < argc) queriesPath = argv[++i];
+        else if (arg == "--threads" && i + 1 < argc) options.threads = std::atoi(argv[++i]);
+        else if (arg == "--quiet") quiet = true;
+        else {
+            usage();
+            return 1;
+        }
+    }
+
+    LabelDictionary dict;
+    TreeCorpus corpus, queries;
+    try {
+        corpus = loadCorpus(corpusPath, dict);
+        if (!queriesPath.empty())
+            queries = loadCorpus(queriesPath, dict);
+    } catch (const std::exception& e) {
+        std::cerr << "Erro: " << e.what() << "\n";
+        return 1;
+    }
+    std::cout << "Corpus: " << corpus.size() << " arvores";
+    if (!queriesPath.empty()) std::cout << ", consultas: " << queries.size() << " arvores";
+    std::cout << ", " << dict.labels.size() << " rotulos distintos\n\n";
+
+    JoinStats stats;
+    auto pairs = queriesPath.empty()
+        ? similarityJoin(corpus, tau, stats, options)
+        : similarityJoin(queries, corpus, tau, stats, options);
+
+    if (!quiet) {
+        for (const auto& p : pairs)
+            std::cout << p.left << " " << p.right << " " << p.distance << "\n";
+        std::cout << "\n";
+    }
+    printJoinStats(stats);
+    return 0;
+}
@@ -0,0 +1,286 @@
+#include "tree_parse.h"
+#include <chrono>
+#include <cstring>
+#include <fcntl.h>
+#include <stdexcept>
+#include <string_view>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <unordered_map>
+#include <vector>
+
+MappedFile::MappedFile(const std::string& path, bool sequential) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) throw std::runtime_error("nao foi possivel abrir " + path);
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        ::close(fd);
+        throw std::runtime_error("nao foi possivel ler o tamanho de " + path);
+    }
+    length = st.st_size;
+    if (length > 0) {
+        void* p = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (p == MAP_FAILED) {
+            ::close(fd);
+            throw std::runtime_error("mmap falhou para " + path);
+        }
+        madvise(p, length, sequential ? MADV_SEQUENTIAL : MADV_RANDOM);
+        ptr = static_cast<const char*>(p);
+    }
+    ::close(fd);
+}
+
+MappedFile::~MappedFile() {
+    if (ptr) munmap(const_cast<char*>(ptr), length);
+}
+
+TreeFormat formatFromPath(const std::string& path) {
+    auto endsWith = [&](const char* ext) {
+        size_t len = std::strlen(ext);
+        return path.size() >= len && path.compare(path.size() - len, len, ext) == 0;
+    };
+    if (endsWith(".xml")) return TreeFormat::Xml;
+    if (endsWith(".json")) return TreeFormat::Json;
+    return TreeFormat::Bracket;
+}
+
+namespace {
+
+// PostorderBuilder com cache dos rotulos ja vistos neste texto: evita criar
+// uma std::string por no ao consultar o dicionario.
+struct TextBuilder : PostorderBuilder {
+    LabelDictionary& dict;
+    std::unordered_map<std::string_view, int> cache;
+
+    explicit TextBuilder(LabelDictionary& d) : dict(d) {}
+
+    int label(std::string_view text) {
+        auto it = cache.find(text);
+        if (it != cache.end()) return it->second;
+        int id = dict.intern(std::string(text));
+        cache.emplace(text, id);
+        return id;
+    }
+};
+
+[[noreturn]] void syntaxError(const char* what, size_t pos) {
+    throw std::runtime_error(std::string(what) + " (byte " + std::to_string(pos) + ")");
+}
+
+inline bool isSpace(char c) {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+// Le uma arvore em colchetes a partir de pos; devolve false se so restar espaco.
+bool parseBracketTree(const char* data, size_t size, size_t& pos, TextBuilder& b) {
+    while (pos < size && isSpace(data[pos])) ++pos;
+    if (pos >= size) return false;
+    if (data[pos] != '{') syntaxError("esperado '{'", pos);
+    do {
+        char c = data[pos];
+        if (c == '{') {
+            size_t start = ++pos;
+            while (pos < size && data[pos] != '{' && data[pos] != '}') ++pos;
+            if (pos >= size) syntaxError("chave nao fechada", start - 1);
+            b.openNode(b.label(std::string_view(data + start, pos - start)));
+        } else if (c == '}') {
+            b.closeNode();
+            ++pos;
+        } else if (isSpace(c)) {
+            ++pos;
+        } else {
+            syntaxError("caractere fora de um no", pos);
+        }
+        if (!b.open.empty() && pos >= size) syntaxError("chave nao fechada", pos);
+    } while (!b.open.empty());
+    return true;
+}
+
+void parseXml(const char* data, size_t size, TextBuilder& b) {
+    std::vector<std::string_view> names;
+    size_t pos = 0;
+    bool seenRoot = false;
+    auto skipPast = [&](const char* terminator, size_t from) {
+        const char* end = (const char*)memmem(data + pos, size - pos, terminator, std::strlen(terminator));
+        if (!end) syntaxError("construcao XML nao terminada", from);
+        pos = (end - data) + std::strlen(terminator);
+    };
+    while (pos < size) {
+        const char* lt = (const char*)std::memchr(data + pos, '<', size - pos);
+        if (!lt) break;
+        size_t start = lt - data;
+        pos = start + 1;
+        if (pos >= size) syntaxError("tag nao terminada", start);
+        char c = data[pos];
+        if (c == '?') { skipPast("?>", start); continue; }
+        if (c == '!') {
+            if (size - pos >= 3 && std::memcmp(data + pos, "!--", 3) == 0) skipPast("-->", start);
+            else if (size - pos >= 8 && std::memcmp(data + pos, "![CDATA[", 8) == 0) skipPast("]]>", start);
+            else skipPast(">", start); // DOCTYPE sem subconjunto interno
+            continue;
+        }
+        bool closing = c == '/';
+        if (closing) ++pos;
+        size_t nameStart = pos;
+        while (pos < size && !isSpace(data[pos]) && data[pos] != '>' && data[pos] != '/') ++pos;
+        std::string_view name(data + nameStart, pos - nameStart);
+        if (name.empty()) syntaxError("tag sem nome", start);
+        // Atributos: pula ate '>' respeitando valores entre aspas.
+        char quote = 0;
+        while (pos < size && (quote || data[pos] != '>')) {
+            if (quote) { if (data[pos] == quote) quote = 0; }
+            else if (data[pos] == '"' || data[pos] == '\'') quote = data[pos];
+            ++pos;
+        }
+        if (pos >= size) syntaxError("tag nao terminada", start);
+        bool selfClosing = data[pos - 1] == '/';
+        ++pos;
+        if (closing) {
+            if (names.empty() || names.back() != name) syntaxError("tag de fechamento inesperada", start);
+            names.pop_back();
+            b.closeNode();
+        } else {
+            if (names.empty() && seenRoot) syntaxError("mais de um elemento raiz", start);
+            seenRoot = true;
+            b.openNode(b.label(name));
+            if (selfClosing) b.closeNode();
+            else names.push_back(name);
+        }
+    }
+    if (!names.empty()) syntaxError("elemento nao fechado", size);
+}
+
+void parseJson(const char* data, size_t size, TextBuilder& b) {
+    enum Ctx : char { Object, Array, Member };
+    std::vector<Ctx> ctx;
+    size_t pos = 0;
+    int objLabel = b.label("{}"), arrLabel = b.label("[]");
+    int strLabel = b.label("#string"), numLabel = b.label("#number");
+    int boolLabel = b.label("#bool"), nullLabel = b.label("#null");
+
+    auto skipWs = [&] { while (pos < size && isSpace(data[pos])) ++pos; };
+    auto expect = [&](char c) {
+        skipWs();
+        if (pos >= size || data[pos] != c) syntaxError("caractere inesperado no JSON", pos);
+        ++pos;
+    };
+    // Devolve o conteudo de uma string JSON (escapes preservados).
+    auto readString = [&]() {
+        skipWs();
+        if (pos >= size || data[pos] != '"') syntaxError("esperada string", pos);
+        size_t start = ++pos;
+        while (pos < size && data[pos] != '"') pos += data[pos] == '\\' ? 2 : 1;
+        if (pos >= size) syntaxError("string nao terminada", start - 1);
+        return std::string_view(data + start, pos++ - start);
+    };
+    auto openMember = [&] {
+        b.openNode(b.label(readString()));
+        ctx.push_back(Member);
+        expect(':');
+    };
+
+    for (;;) {
+        // Inicio de um valor.
+        skipWs();
+        if (pos >= size) syntaxError("esperado valor JSON", pos);
+        char c = data[pos];
+        if (c == '{' || c == '[') {
+            ++pos;
+            b.openNode(c == '{' ? objLabel : arrLabel);
+            ctx.push_back(c == '{' ? Object : Array);
+            skipWs();
+            if (pos >= size) syntaxError("fim inesperado da entrada no JSON", pos);
+            char end = c == '{' ? '}' : ']';
+            if (data[pos] != end) {
+                if (c == '{') openMember();
+                continue;
+            }
+            ++pos;
+            b.closeNode();
+            ctx.pop_back();
+        } else if (c == '"') {
+            readString();
+            b.openNode(strLabel);
+            b.closeNode();
+        } else {
+            size_t start = pos;
+            while (pos < size && !isSpace(data[pos]) && data[pos] != ',' && data[pos] != '}' && data[pos] != ']') ++pos;
+            std::string_view lit(data + start, pos - start);
+            int label;
+            if (lit == "true" || lit == "false") label = boolLabel;
+            else if (lit == "null") label = nullLabel;
+            else if (!lit.empty() && (lit[0] == '-' || (lit[0] >= '0' && lit[0] <= '9'))) label = numLabel;
+            else syntaxError("valor JSON invalido", start);
+            b.openNode(label);
+            b.closeNode();
+        }
+
+        // Fim de um valor: fecha membros e containers ate precisar de outro valor.
+        bool needValue = false;
+        while (!ctx.empty() && !needValue) {
+            if (ctx.back() == Member) {
+                b.closeNode();
+                ctx.pop_back();
+                skipWs();
+                if (pos < size && data[pos] == ',') { ++pos; openMember(); needValue = true; }
+                else { expect('}'); b.closeNode(); ctx.pop_back(); }
+            } else {
+                skipWs();
+                if (pos < size && data[pos] == ',') { ++pos; needValue = true; }
+                else { expect(']'); b.closeNode(); ctx.pop_back(); }
+            }
+        }
+        if (!needValue) break;
+    }
+    skipWs();
+    if (pos < size) syntaxError("conteudo apos o valor JSON", pos);
+}
+
+} // namespace
+
+PostorderTree parseTree(const char* data, size_t size, TreeFormat format, LabelDictionary& dict) {
+    TextBuilder b(dict);
+    size_t pos = 0;
+    switch (format) {
+    case TreeFormat::Bracket:
+        parseBracketTree(data, size, pos, b);
+        while (pos < size && isSpace(data[pos])) ++pos;
+        if (pos < size) syntaxError("conteudo apos a arvore", pos);
+        break;
+    case TreeFormat::Xml:
+        parseXml(data, size, b);
+        break;
+    case TreeFormat::Json:
+        parseJson(data, size, b);
+        break;
+    }
+    return b.finish();
+}
+
+PostorderTree parseTreeFile(const std::string& path, LabelDictionary& dict, ParseStats* stats) {
+    auto t0 = std::chrono::high_resolution_clock::now();
+    MappedFile file(path);
+    PostorderTree tree;
+    try {
+        tree = parseTree(file.data(), file.size(), formatFromPath(path), dict);
+    } catch (const std::runtime_error& e) {
+        throw std::runtime_error(path + ": " + e.what());
+    }
+    auto t1 = std::chrono::high_resolution_clock::now();
+    if (stats) {
+        stats->bytes = file.size();
+        stats->nodes = tree.size();
+        stats->ms = std::chrono::duration<double, std::milli>(t1 - t0).count();
+        stats->mbPerSecond = stats->ms > 0 ? (file.size() / (1024.0 * 1024.0)) / (stats->ms / 1000.0) : 0;
+    }
+    return tree;
+}
+
+void parseBracketForest(const char* data, size_t size, LabelDictionary& dict,
+                        const std::function<void(PostorderTree&&)>& onTree) {
+    TextBuilder b(dict);
+    size_t pos = 0;
+    while (parseBracketTree(data, size, pos, b))
+        onTree(b.finish());
+}
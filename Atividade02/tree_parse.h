@@ -0,0 +1,60 @@
+#ifndef TREE_PARSE_H
+#define TREE_PARSE_H
+
+#include "tree_edit.h"
+#include <cstddef>
+#include <functional>
+#include <string>
+
+// Arquivo mapeado em memoria (mmap), somente leitura. sequential avisa o
+// kernel de que a leitura sera do inicio ao fim (parsers); acessos
+// aleatorios (TreeStore) devem passar false.
+class MappedFile {
+public:
+    explicit MappedFile(const std::string& path, bool sequential = true);
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    const char* data() const { return ptr; }
+    size_t size() const { return length; }
+
+private:
+    const char* ptr = nullptr;
+    size_t length = 0;
+};
+
+enum class TreeFormat { Bracket, Xml, Json };
+
+// Formato pela extensao: .xml, .json; qualquer outra eh notacao de colchetes.
+TreeFormat formatFromPath(const std::string& path);
+
+struct ParseStats {
+    size_t bytes = 0;
+    int nodes = 0;
+    double ms = 0;
+    double mbPerSecond = 0;
+};
+
+// Os parsers leem o texto em uma unica passada, com pilha explicita, e
+// emitem os nos direto em pos-ordem (o lld de um no eh o indice de pos-ordem
+// corrente quando ele eh aberto). Nenhum Node* eh criado. Erros de sintaxe
+// lancam std::runtime_error com o deslocamento no arquivo.
+//
+// Colchetes: {A{B}{C}}. O rotulo vai ate o proximo '{' ou '}'.
+// XML: cada elemento vira um no rotulado pelo nome da tag; texto,
+//      atributos, comentarios, CDATA e instrucoes sao ignorados.
+// JSON: objeto -> "{}", com um filho por membro rotulado pela chave (e o
+//       valor como filho do membro); array -> "[]"; escalares viram folhas
+//       rotuladas pelo tipo: "#string", "#number", "#bool", "#null".
+PostorderTree parseTree(const char* data, size_t size, TreeFormat format, LabelDictionary& dict);
+
+PostorderTree parseTreeFile(const std::string& path, LabelDictionary& dict, ParseStats* stats = nullptr);
+
+// Varias arvores em notacao de colchetes no mesmo texto (uma por linha nos
+// corpora); cada arvore completa eh entregue a onTree.
+void parseBracketForest(const char* data, size_t size, LabelDictionary& dict,
+                        const std::function<void(PostorderTree&&)>& onTree);
+
+#endif
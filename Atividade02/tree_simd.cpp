@@ -0,0 +1,152 @@
+#include "tree_simd.h"
+#include <algorithm>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define TREE_SIMD_X86 1
+#endif
+
+template <typename Cell>
+static void scanScalar(Cell* row, int cols) {
+    for (int c = 1; c < cols; ++c)
+        row[c] = std::min<Cell>(row[c], row[c-1] + 1);
+}
+
+#ifdef TREE_SIMD_X86
+
+// Lanes deslocadas para cima recebem um valor enorme (saturado em uint16,
+// 2^30 em int32), para nunca vencerem o minimo.
+static const int32_t big32 = 1 << 30;
+
+__attribute__((target("sse4.1")))
+static void scanSse41_16(uint16_t* row, int cols) {
+    const __m128i s1 = _mm_setr_epi16(-1, 1, 1, 1, 1, 1, 1, 1);
+    const __m128i s2 = _mm_setr_epi16(-1, -1, 2, 2, 2, 2, 2, 2);
+    const __m128i s4 = _mm_setr_epi16(-1, -1, -1, -1, 4, 4, 4, 4);
+    const __m128i ramp = _mm_setr_epi16(1, 2, 3, 4, 5, 6, 7, 8);
+    int c = 1;
+    for (; c + 8 <= cols; c += 8) {
+        __m128i x = _mm_loadu_si128((const __m128i*)(row + c));
+        x = _mm_min_epu16(x, _mm_adds_epu16(_mm_slli_si128(x, 2), s1));
+        x = _mm_min_epu16(x, _mm_adds_epu16(_mm_slli_si128(x, 4), s2));
+        x = _mm_min_epu16(x, _mm_adds_epu16(_mm_slli_si128(x, 8), s4));
+        x = _mm_min_epu16(x, _mm_adds_epu16(_mm_set1_epi16((short)row[c-1]), ramp));
+        _mm_storeu_si128((__m128i*)(row + c), x);
+    }
+    for (; c < cols; ++c)
+        row[c] = std::min<uint16_t>(row[c], row[c-1] + 1);
+}
+
+__attribute__((target("sse4.1")))
+static void scanSse41_32(int32_t* row, int cols) {
+    const __m128i s1 = _mm_setr_epi32(big32, 1, 1, 1);
+    const __m128i s2 = _mm_setr_epi32(big32, big32, 2, 2);
+    const __m128i ramp = _mm_setr_epi32(1, 2, 3, 4);
+    int c = 1;
+    for (; c + 4 <= cols; c += 4) {
+        __m128i x = _mm_loadu_si128((const __m128i*)(row + c));
+        x = _mm_min_epi32(x, _mm_add_epi32(_mm_slli_si128(x, 4), s1));
+        x = _mm_min_epi32(x, _mm_add_epi32(_mm_slli_si128(x, 8), s2));
+        x = _mm_min_epi32(x, _mm_add_epi32(_mm_set1_epi32(row[c-1]), ramp));
+        _mm_storeu_si128((__m128i*)(row + c), x);
+    }
+    for (; c < cols; ++c)
+        row[c] = std::min(row[c], row[c-1] + 1);
+}
+
+// Desloca o vetor de 256 bits inteiro k bytes para cima (as instrucoes de
+// deslocamento do AVX2 agem em cada metade de 128 bits separadamente).
+template <int k>
+__attribute__((target("avx2")))
+static inline __m256i shiftUp256(__m256i x) {
+    __m256i low = _mm256_permute2x128_si256(x, x, 0x08); // [0, metade baixa]
+    if constexpr (k < 16) return _mm256_alignr_epi8(x, low, 16 - k);
+    else return _mm256_slli_si256(low, k - 16);
+}
+
+__attribute__((target("avx2")))
+static void scanAvx2_16(uint16_t* row, int cols) {
+    const __m256i s1 = _mm256_setr_epi16(-1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1);
+    const __m256i s2 = _mm256_setr_epi16(-1, -1, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2);
+    const __m256i s4 = _mm256_setr_epi16(-1, -1, -1, -1, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4);
+    const __m256i s8 = _mm256_setr_epi16(-1, -1, -1, -1, -1, -1, -1, -1, 8, 8, 8, 8, 8, 8, 8, 8);
+    const __m256i ramp = _mm256_setr_epi16(1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16);
+    int c = 1;
+    for (; c + 16 <= cols; c += 16) {
+        __m256i x = _mm256_loadu_si256((const __m256i*)(row + c));
+        x = _mm256_min_epu16(x, _mm256_adds_epu16(shiftUp256<2>(x), s1));
+        x = _mm256_min_epu16(x, _mm256_adds_epu16(shiftUp256<4>(x), s2));
+        x = _mm256_min_epu16(x, _mm256_adds_epu16(shiftUp256<8>(x), s4));
+        x = _mm256_min_epu16(x, _mm256_adds_epu16(shiftUp256<16>(x), s8));
+        x = _mm256_min_epu16(x, _mm256_adds_epu16(_mm256_set1_epi16((short)row[c-1]), ramp));
+        _mm256_storeu_si256((__m256i*)(row + c), x);
+    }
+    for (; c < cols; ++c)
+        row[c] = std::min<uint16_t>(row[c], row[c-1] + 1);
+}
+
+__attribute__((target("avx2")))
+static void scanAvx2_32(int32_t* row, int cols) {
+    const __m256i s1 = _mm256_setr_epi32(big32, 1, 1, 1, 1, 1, 1, 1);
+    const __m256i s2 = _mm256_setr_epi32(big32, big32, 2, 2, 2, 2, 2, 2);
+    const __m256i s4 = _mm256_setr_epi32(big32, big32, big32, big32, 4, 4, 4, 4);
+    const __m256i ramp = _mm256_setr_epi32(1, 2, 3, 4, 5, 6, 7, 8);
+    int c = 1;
+    for (; c + 8 <= cols; c += 8) {
+        __m256i x = _mm256_loadu_si256((const __m256i*)(row + c));
+        x = _mm256_min_epi32(x, _mm256_add_epi32(shiftUp256<4>(x), s1));
+        x = _mm256_min_epi32(x, _mm256_add_epi32(shiftUp256<8>(x), s2));
+        x = _mm256_min_epi32(x, _mm256_add_epi32(shiftUp256<16>(x), s4));
+        x = _mm256_min_epi32(x, _mm256_add_epi32(_mm256_set1_epi32(row[c-1]), ramp));
+        _mm256_storeu_si256((__m256i*)(row + c), x);
+    }
+    for (; c < cols; ++c)
+        row[c] = std::min(row[c], row[c-1] + 1);
+}
+
+#endif
+
+const char* rowKernelName(RowKernel kernel) {
+    switch (kernel) {
+    case RowKernel::Auto: return "auto";
+    case RowKernel::Scalar: return "scalar";
+    case RowKernel::Sse41: return "sse4.1";
+    case RowKernel::Avx2: return "avx2";
+    }
+    return "?";
+}
+
+static RowKernel detectRowKernel() {
+#ifdef TREE_SIMD_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) return RowKernel::Avx2;
+    if (__builtin_cpu_supports("sse4.1")) return RowKernel::Sse41;
+#endif
+    return RowKernel::Scalar;
+}
+
+RowKernel resolveRowKernel(RowKernel kernel) {
+    static const RowKernel best = detectRowKernel();
+    if (kernel == RowKernel::Auto || (int)kernel > (int)best) return best;
+    return kernel;
+}
+
+RowScan16 rowScanKernel16(RowKernel kernel) {
+    switch (resolveRowKernel(kernel)) {
+#ifdef TREE_SIMD_X86
+    case RowKernel::Avx2: return scanAvx2_16;
+    case RowKernel::Sse41: return scanSse41_16;
+#endif
+    default: return scanScalar<uint16_t>;
+    }
+}
+
+RowScan32 rowScanKernel32(RowKernel kernel) {
+    switch (resolveRowKernel(kernel)) {
+#ifdef TREE_SIMD_X86
+    case RowKernel::Avx2: return scanAvx2_32;
+    case RowKernel::Sse41: return scanSse41_32;
+#endif
+    default: return scanScalar<int32_t>;
+    }
+}
@@ -0,0 +1,33 @@
+#ifndef TREE_SIMD_H
+#define TREE_SIMD_H
+
+#include <cstdint>
+
+// Varredura de linha do forestdist. Depois de calcular, para cada coluna, o
+// minimo entre delecao e substituicao/"tree" (que so dependem da linha
+// anterior), resta a dependencia da insercao dentro da propria linha:
+//     row[c] = min(row[c], row[c-1] + 1),   c = 1 .. cols-1
+// que eh um prefixo-minimo com inclinacao 1. As versoes vetoriais resolvem
+// um vetor inteiro por vez em log2(largura) passos de deslocamento + minimo,
+// propagando o ultimo valor para o vetor seguinte.
+enum class RowKernel {
+    Auto,   // melhor disponivel na CPU (detectado uma vez)
+    Scalar,
+    Sse41,
+    Avx2
+};
+
+const char* rowKernelName(RowKernel kernel);
+
+// Resolve Auto para o melhor kernel suportado e rebaixa um kernel pedido que
+// a CPU nao suporta.
+RowKernel resolveRowKernel(RowKernel kernel);
+
+using RowScan16 = void (*)(uint16_t* row, int cols);
+using RowScan32 = void (*)(int32_t* row, int cols);
+
+// Valores de int32 devem ficar abaixo de 2^30 (sentinela dos deslocamentos).
+RowScan16 rowScanKernel16(RowKernel kernel);
+RowScan32 rowScanKernel32(RowKernel kernel);
+
+#endif
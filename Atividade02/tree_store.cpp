@@ -0,0 +1,203 @@
+#include "tree_store.h"
+#include <cstddef>
+#include <cstring>
+#include <filesystem>
+#include <stdexcept>
+#include <unistd.h>
+
+namespace {
+
+const char storeMagic[8] = {'T', 'E', 'D', 'S', 'T', 'O', 'R', 'E'};
+const uint32_t storeVersion = 1;
+const uint32_t byteOrderMark = 0x01020304;
+const uint32_t labelRecord = 1;
+const uint32_t treeRecord = 2;
+
+struct StoreHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t byteOrder;
+    uint64_t committed; // bytes validos, contando o cabecalho
+    uint64_t trees;
+    uint64_t labels;
+    char reserved[24];
+};
+static_assert(sizeof(StoreHeader) == 64, "cabecalho do armazem deve ter 64 bytes");
+
+size_t paddedWords(size_t bytes) {
+    return (bytes + 3) / 4;
+}
+
+// Confere uma arvore lida do arquivo antes de entrega-la ao motor de TED,
+// que indexa por lld e keyroots sem checar limites. Uma passada linear, sem
+// copiar os vetores. Os intervalos [lld(i), i] precisam formar uma arvore:
+// com uma pilha das raizes ja fechadas (que cobrem [0, i) em ordem), o no i
+// adota as do topo com lld >= lld(i), e o que sobra precisa terminar
+// exatamente em lld(i) - 1. Devolve o motivo da rejeicao, ou nullptr.
+const char* invalidTree(const PostorderView& t, uint64_t labelCount, std::vector<int>& stack) {
+    int n = t.size();
+    stack.clear();
+    for (int i = 0; i < n; ++i) {
+        if (t.labels[i] < 0 || (uint64_t)t.labels[i] >= labelCount) return "rotulo fora do dicionario";
+        int l = t.lld[i];
+        if (l < 0 || l > i) return "lld fora do intervalo";
+        if (t.sizes[i] != i - l + 1) return "tamanho de subarvore inconsistente";
+        while (!stack.empty() && t.lld[stack.back()] >= l) stack.pop_back();
+        if ((stack.empty() ? 0 : stack.back() + 1) != l) return "lld nao forma uma arvore";
+        stack.push_back(i);
+    }
+    if (n > 0 && stack.size() != 1) return "lld nao forma uma arvore";
+    for (size_t j = 0; j < t.keyroots.size(); ++j) {
+        int k = t.keyroots[j];
+        if (k < 0 || k >= n) return "keyroot fora do intervalo";
+        if (j > 0 && k <= t.keyroots[j - 1]) return "keyroots fora de ordem";
+    }
+    return nullptr;
+}
+
+} // namespace
+
+TreeStore::TreeStore(const std::string& path) : file(path, false) {
+    auto bad = [&](const std::string& why) { return std::runtime_error(path + ": " + why); };
+    if (file.size() < sizeof(StoreHeader)) throw bad("armazem invalido (arquivo curto)");
+    StoreHeader header;
+    std::memcpy(&header, file.data(), sizeof header);
+    if (std::memcmp(header.magic, storeMagic, sizeof storeMagic) != 0) throw bad("nao eh um armazem de arvores");
+    if (header.byteOrder != byteOrderMark) throw bad("ordem de bytes diferente da desta maquina");
+    if (header.version != storeVersion) throw bad("versao " + std::to_string(header.version) + " nao suportada");
+    if (header.committed < sizeof header || header.committed > file.size()) throw bad("tamanho confirmado invalido");
+    formatVersion = header.version;
+    committed = header.committed;
+
+    // Percorre os registros so para achar o inicio de cada arvore; os
+    // vetores ficam onde estao, no arquivo mapeado.
+    const uint32_t* words = reinterpret_cast<const uint32_t*>(file.data());
+    size_t pos = sizeof header / 4, limit = committed / 4;
+    trees.reserve(header.trees);
+    std::vector<int> stack;
+    while (pos < limit) {
+        if (limit - pos < 2) throw bad("registro truncado");
+        uint32_t type = words[pos];
+        if (type == labelRecord) {
+            size_t length = words[pos + 1];
+            if (paddedWords(length) > limit - pos - 2) throw bad("rotulo truncado");
+            dict.intern(std::string(reinterpret_cast<const char*>(words + pos + 2), length));
+            pos += 2 + paddedWords(length);
+        } else if (type == treeRecord) {
+            if (limit - pos < 4) throw bad("arvore truncada");
+            size_t n = words[pos + 1], k = words[pos + 2];
+            if (3 * n + k > limit - pos - 4) throw bad("arvore truncada");
+            const int* data = reinterpret_cast<const int*>(words + pos + 4);
+            PostorderView view;
+            view.labels = IntSpan(data, n);
+            view.lld = IntSpan(data + n, n);
+            view.keyroots = IntSpan(data + 2 * n, k);
+            view.sizes = IntSpan(data + 2 * n + k, n);
+            if (const char* why = invalidTree(view, header.labels, stack))
+                throw bad("arvore " + std::to_string(trees.size()) + " invalida: " + why);
+            trees.push_back(view);
+            pos += 4 + 3 * n + k;
+        } else {
+            throw bad("tipo de registro desconhecido");
+        }
+    }
+    if (trees.size() != header.trees || dict.labels.size() != header.labels)
+        throw bad("contagens do cabecalho nao conferem");
+}
+
+TreeStoreWriter::TreeStoreWriter(const std::string& storePath) : path(storePath) {
+    bool exists = std::filesystem::exists(path) && std::filesystem::file_size(path) > 0;
+    if (exists) {
+        TreeStore store(path);
+        dict = store.labels();
+        treeCount = store.size();
+        end = store.bytes();
+        file = std::fopen(path.c_str(), "r+b");
+        if (!file) throw std::runtime_error("nao foi possivel abrir " + path);
+        // descarta o que foi escrito depois do ultimo commit
+        if (ftruncate(fileno(file), end) != 0) {
+            std::fclose(file);
+            throw std::runtime_error("nao foi possivel truncar " + path);
+        }
+        std::fseek(file, end, SEEK_SET);
+    } else {
+        file = std::fopen(path.c_str(), "w+b");
+        if (!file) throw std::runtime_error("nao foi possivel criar " + path);
+        StoreHeader header{};
+        std::memcpy(header.magic, storeMagic, sizeof storeMagic);
+        header.version = storeVersion;
+        header.byteOrder = byteOrderMark;
+        header.committed = sizeof header;
+        std::fwrite(&header, sizeof header, 1, file);
+        end = sizeof header;
+        commit();
+    }
+}
+
+TreeStoreWriter::~TreeStoreWriter() {
+    try {
+        commit();
+    } catch (const std::exception&) {
+        // o destrutor nao propaga; os registros sem commit ficam invalidos
+    }
+    if (file) std::fclose(file);
+}
+
+void TreeStoreWriter::writeWords(const void* data, size_t words) {
+    if (words && std::fwrite(data, 4, words, file) != words)
+        throw std::runtime_error("erro ao gravar " + path);
+    end += words * 4;
+}
+
+int TreeStoreWriter::append(const PostorderTree& tree, const LabelDictionary& source) {
+    int n = tree.size();
+    if ((int)tree.lld.size() != n) throw std::runtime_error("arvore sem lld para cada no");
+    if (&source != lastSource) {
+        lastSource = &source;
+        translation.clear();
+    }
+    if (translation.size() < source.labels.size()) translation.resize(source.labels.size(), -1);
+
+    std::vector<int> labels(n);
+    for (int i = 0; i < n; ++i) {
+        int& id = translation[tree.labels[i]];
+        if (id < 0) {
+            size_t before = dict.labels.size();
+            const std::string& text = source.labels[tree.labels[i]];
+            id = dict.intern(text);
+            if (dict.labels.size() != before) {
+                uint32_t head[2] = {labelRecord, (uint32_t)text.size()};
+                writeWords(head, 2);
+                std::vector<char> padded(paddedWords(text.size()) * 4, 0);
+                std::memcpy(padded.data(), text.data(), text.size());
+                writeWords(padded.data(), padded.size() / 4);
+            }
+        }
+        labels[i] = id;
+    }
+    uint32_t head[4] = {treeRecord, (uint32_t)n, (uint32_t)tree.keyroots.size(), 0};
+    writeWords(head, 4);
+    writeWords(labels.data(), labels.size());
+    writeWords(tree.lld.data(), tree.lld.size());
+    writeWords(tree.keyroots.data(), tree.keyroots.size());
+    if ((int)tree.sizes.size() == n) {
+        writeWords(tree.sizes.data(), n);
+    } else {
+        std::vector<int> sizes(n);
+        for (int i = 0; i < n; ++i) sizes[i] = i - tree.lld[i] + 1;
+        writeWords(sizes.data(), n);
+    }
+    return treeCount++;
+}
+
+void TreeStoreWriter::commit() {
+    // Primeiro os registros chegam ao disco; so depois o cabecalho passa a
+    // conta-los.
+    if (std::fflush(file) != 0 || fsync(fileno(file)) != 0)
+        throw std::runtime_error("erro ao gravar " + path);
+    uint64_t counts[3] = {end, (uint64_t)treeCount, (uint64_t)dict.labels.size()};
+    std::fseek(file, offsetof(StoreHeader, committed), SEEK_SET);
+    bool ok = std::fwrite(counts, sizeof counts, 1, file) == 1 && std::fflush(file) == 0 && fsync(fileno(file)) == 0;
+    std::fseek(file, end, SEEK_SET);
+    if (!ok) throw std::runtime_error("erro ao gravar o cabecalho de " + path);
+}
@@ -0,0 +1,81 @@
+#ifndef TREE_STORE_H
+#define TREE_STORE_H
+
+#include "tree_edit.h"
+#include "tree_parse.h"
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+// Armazem em disco de arvores pre-processadas, lido com mmap. O nucleo do
+// Zhang-Shasha le os vetores direto do arquivo mapeado (PostorderView), sem
+// desserializar nada alem do dicionario de rotulos.
+//
+// Formato (inteiros na ordem de bytes da maquina, tudo alinhado em 4 bytes):
+//   cabecalho de 64 bytes: "TEDSTORE", versao, marca de ordem de bytes,
+//     bytes confirmados, numero de arvores, numero de rotulos
+//   registros, so acrescentados ao final:
+//     rotulo: tipo=1, tamanho, bytes (completados ate multiplo de 4)
+//     arvore: tipo=2, n, k, 0, labels[n], lld[n], keyroots[k], sizes[n]
+// Os rotulos recebem ids na ordem em que aparecem. Um registro so vale depois
+// de commit, que atualiza os bytes confirmados no cabecalho: uma escrita
+// interrompida no meio eh ignorada pelos leitores e descartada pelo proximo
+// TreeStoreWriter.
+
+class TreeStore {
+public:
+    // Mapeia o arquivo e confere cada arvore (lld, tamanhos, keyroots e
+    // rotulos) em uma passada, lancando std::runtime_error se algo estiver
+    // fora do lugar. Acrescimos feitos depois nao aparecem: abra de novo.
+    explicit TreeStore(const std::string& path);
+
+    int size() const { return (int)trees.size(); }
+    // Valida enquanto o TreeStore existir.
+    PostorderView tree(int i) const { return trees[i]; }
+    // Consultas devem ser pre-processadas com uma copia deste dicionario,
+    // para que rotulos iguais tenham o mesmo id.
+    const LabelDictionary& labels() const { return dict; }
+    uint32_t version() const { return formatVersion; }
+    size_t bytes() const { return committed; }
+
+private:
+    MappedFile file;
+    LabelDictionary dict;
+    std::vector<PostorderView> trees;
+    uint32_t formatVersion = 0;
+    size_t committed = 0;
+};
+
+class TreeStoreWriter {
+public:
+    // Abre para acrescentar, criando o arquivo se ele nao existir.
+    explicit TreeStoreWriter(const std::string& path);
+    ~TreeStoreWriter(); // commit e fecha
+
+    TreeStoreWriter(const TreeStoreWriter&) = delete;
+    TreeStoreWriter& operator=(const TreeStoreWriter&) = delete;
+
+    // Acrescenta uma arvore cujos rotulos sao ids de source; eles sao
+    // traduzidos para o dicionario do armazem. Devolve o indice da arvore.
+    int append(const PostorderTree& tree, const LabelDictionary& source);
+
+    // Grava os registros pendentes e atualiza o cabecalho.
+    void commit();
+
+    int size() const { return treeCount; }
+    const LabelDictionary& labels() const { return dict; }
+
+private:
+    void writeWords(const void* data, size_t words);
+
+    std::string path;
+    std::FILE* file = nullptr;
+    LabelDictionary dict;
+    uint64_t end = 0;
+    int treeCount = 0;
+    const LabelDictionary* lastSource = nullptr;
+    std::vector<int> translation; // id em lastSource -> id no armazem (-1 = ainda nao visto)
+};
+
+#endif
@@ -0,0 +1,68 @@
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include "tree_store.h"
+
+static void usage() {
+    std::cerr << "Uso: tree_store add <armazem> <arquivo>...   acrescenta arvores (colchetes: uma por linha; .xml/.json: uma por arquivo)\n"
+              << "     tree_store info <armazem>               versao, arvores, rotulos e tamanho\n"
+              << "     tree_store ted <armazem> <i> <j>        distancia de edicao entre as arvores i e j\n";
+}
+
+static int add(const std::string& storePath, int count, char** files) {
+    TreeStoreWriter writer(storePath);
+    int before = writer.size();
+    LabelDictionary dict;
+    for (int f = 0; f < count; ++f) {
+        std::string path = files[f];
+        if (formatFromPath(path) == TreeFormat::Bracket) {
+            MappedFile file(path);
+            parseBracketForest(file.data(), file.size(), dict, [&](PostorderTree&& tree) {
+                writer.append(tree, dict);
+            });
+        } else {
+            writer.append(parseTreeFile(path, dict), dict);
+        }
+    }
+    writer.commit();
+    std::cout << (writer.size() - before) << " arvores acrescentadas; total " << writer.size() << "\n";
+    return 0;
+}
+
+int main(int argc, char** argv) {
+    if (argc < 3) {
+        usage();
+        return 1;
+    }
+    std::string command = argv[1], storePath = argv[2];
+    try {
+        if (command == "add" && argc >= 4)
+            return add(storePath, argc - 3, argv + 3);
+        if (command == "info" && argc == 3) {
+            TreeStore store(storePath);
+            long long nodes = 0;
+            for (int i = 0; i < store.size(); ++i) nodes += store.tree(i).size();
+            std::cout << "Versao:  " << store.version() << "\n"
+                      << "Arvores: " << store.size() << "\n"
+                      << "Nos:     " << nodes << "\n"
+                      << "Rotulos: " << store.labels().labels.size() << "\n"
+                      << "Bytes:   " << store.bytes() << "\n";
+            return 0;
+        }
+        if (command == "ted" && argc == 5) {
+            TreeStore store(storePath);
+            int i = std::atoi(argv[3]), j = std::atoi(argv[4]);
+            if (i < 0 || j < 0 || i >= store.size() || j >= store.size()) {
+                std::cerr << "Erro: indices fora do intervalo [0, " << store.size() << ")\n";
+                return 1;
+            }
+            std::cout << treeEditDistance(store.tree(i), store.tree(j)) << "\n";
+            return 0;
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Erro: " << e.what() << "\n";
+        return 1;
+    }
+    usage();
+    return 1;
+}
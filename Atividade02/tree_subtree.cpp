@@ -0,0 +1,50 @@
+#include "tree_subtree.h"
+#include <algorithm>
+
+static bool betterMatch(const SubtreeMatch& a, const SubtreeMatch& b) {
+    if (a.score != b.score) return a.score < b.score;
+    if (a.distance != b.distance) return a.distance < b.distance;
+    return a.right < b.right;
+}
+
+void streamSubtreeMatches(const PostorderView& t1, const PostorderView& t2, int k,
+                          const std::function<void(int left, const std::vector<SubtreeMatch>& best)>& onRow,
+                          TedOptions options) {
+    int n = t1.size(), m = t2.size();
+    if (n == 0 || k <= 0) return;
+    if (m == 0) {
+        std::vector<SubtreeMatch> none;
+        for (int i = 0; i < n; ++i) onRow(i, none);
+        return;
+    }
+    // Um heap maximo (pior no topo) de ate k entradas por linha.
+    std::vector<std::vector<SubtreeMatch>> heaps(n);
+    options.onTreedist = [&](int i, int j, int d) {
+        SubtreeMatch match{j, d, subtreeScore(d, t1.sizes[i], t2.sizes[j])};
+        auto& heap = heaps[i];
+        if ((int)heap.size() < k) {
+            heap.push_back(match);
+            std::push_heap(heap.begin(), heap.end(), betterMatch);
+        } else if (betterMatch(match, heap.front())) {
+            std::pop_heap(heap.begin(), heap.end(), betterMatch);
+            heap.back() = match;
+            std::push_heap(heap.begin(), heap.end(), betterMatch);
+        }
+    };
+    options.onRowDone = [&](int i) {
+        auto& heap = heaps[i];
+        std::sort_heap(heap.begin(), heap.end(), betterMatch);
+        onRow(i, heap);
+        std::vector<SubtreeMatch>().swap(heap);
+    };
+    treeEditDistance(t1, t2, options);
+}
+
+std::vector<std::vector<SubtreeMatch>> bestSubtreeMatches(const PostorderView& t1, const PostorderView& t2, int k,
+                                                          const TedOptions& options) {
+    std::vector<std::vector<SubtreeMatch>> rows(t1.size());
+    streamSubtreeMatches(t1, t2, k, [&](int left, const std::vector<SubtreeMatch>& best) {
+        rows[left] = best;
+    }, options);
+    return rows;
+}
@@ -0,0 +1,40 @@
+#ifndef TREE_SUBTREE_H
+#define TREE_SUBTREE_H
+
+#include "tree_edit.h"
+#include <functional>
+#include <vector>
+
+// Melhores correspondencias entre subarvores. O Zhang-Shasha ja calcula
+// treedist(i, j) para todo par de subarvores; aqui cada celula eh consumida
+// assim que fica definitiva (TedOptions::onTreedist) e so as k melhores de
+// cada linha sao guardadas, em vez de uma segunda matriz n x m de resultados.
+// A matriz treedist interna do algoritmo continua existindo durante o
+// calculo, porque o caso "tree" le celulas de qualquer par ja resolvido.
+
+struct SubtreeMatch {
+    int right;      // subarvore de T2 (indice de pos-ordem)
+    int distance;   // treedist(i, right)
+    double score;   // distance / (|T1[i]| + |T2[right]|), em [0, 1]
+};
+
+// Score normalizado pelo tamanho: 0 para subarvores iguais, 1 quando nada se
+// aproveita (apagar tudo e inserir tudo).
+inline double subtreeScore(int distance, int size1, int size2) {
+    return (double)distance / (size1 + size2);
+}
+
+// Entrega, para cada subarvore i de T1, as k subarvores de T2 de menor score
+// (empates por distancia e depois por indice), em ordem crescente. Cada linha
+// sai uma vez, assim que fica completa (em ordem de keyroot, nao de indice),
+// e sua memoria eh liberada em seguida. options.onTreedist e onRowDone sao
+// substituidos.
+void streamSubtreeMatches(const PostorderView& t1, const PostorderView& t2, int k,
+                          const std::function<void(int left, const std::vector<SubtreeMatch>& best)>& onRow,
+                          TedOptions options = {});
+
+// O mesmo, com todas as linhas devolvidas em ordem de indice.
+std::vector<std::vector<SubtreeMatch>> bestSubtreeMatches(const PostorderView& t1, const PostorderView& t2, int k,
+                                                          const TedOptions& options = {});
+
+#endif
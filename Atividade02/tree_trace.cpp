@@ -0,0 +1,163 @@
+#include "tree_trace.h"
+#include <chrono>
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+
+static const char traceMagic[8] = {'T', 'E', 'D', 'T', 'R', 'A', 'C', 'E'};
+static const uint32_t traceVersion = 1;
+
+TedTrace::TedTrace(TraceOptions opts) : options(std::move(opts)) {
+    if (options.sampleEvery < 1) options.sampleEvery = 1;
+    size_t capacity = 1;
+    while (capacity < options.bufferRecords) capacity <<= 1;
+    buffer.resize(capacity);
+    mask = capacity - 1;
+    // Zera o contador para que o primeiro registro elegivel seja gravado.
+    sampleCounter = options.sampleEvery - 1;
+}
+
+TedTrace::~TedTrace() {
+    finish();
+}
+
+static bool writeU32(std::FILE* f, uint32_t v) {
+    return std::fwrite(&v, sizeof v, 1, f) == 1;
+}
+
+void TedTrace::begin(const std::vector<std::string>& labels1, const std::vector<std::string>& labels2) {
+    if (drainer.joinable() || file) throw std::runtime_error("rastro ja iniciado: chame finish() antes");
+    head.store(0, std::memory_order_relaxed);
+    tail.store(0, std::memory_order_relaxed);
+    stopping.store(false, std::memory_order_relaxed);
+    failed.store(false, std::memory_order_relaxed);
+    stallCount = 0;
+    sampleCounter = options.sampleEvery - 1;
+    std::filesystem::path path(options.path);
+    if (path.has_parent_path())
+        std::filesystem::create_directories(path.parent_path());
+    file = std::fopen(options.path.c_str(), "wb");
+    if (!file) throw std::runtime_error("nao foi possivel criar " + options.path);
+
+    bool ok = std::fwrite(traceMagic, 1, sizeof traceMagic, file) == sizeof traceMagic;
+    ok = ok && writeU32(file, traceVersion);
+    ok = ok && writeU32(file, options.sampleEvery);
+    ok = ok && writeU32(file, options.treedistOnly ? 1 : 0);
+    for (const auto* labels : {&labels1, &labels2}) {
+        ok = ok && writeU32(file, labels->size());
+        for (const auto& s : *labels) {
+            ok = ok && writeU32(file, s.size());
+            ok = ok && std::fwrite(s.data(), 1, s.size(), file) == s.size();
+        }
+    }
+    if (!ok) {
+        std::fclose(file);
+        file = nullptr;
+        throw std::runtime_error("erro ao gravar " + options.path);
+    }
+    drainer = std::thread(&TedTrace::drainLoop, this);
+}
+
+void TedTrace::drainLoop() {
+    for (;;) {
+        uint64_t t = tail.load(std::memory_order_relaxed);
+        uint64_t h = head.load(std::memory_order_acquire);
+        if (h == t) {
+            if (stopping.load(std::memory_order_acquire) && head.load(std::memory_order_acquire) == t) break;
+            std::this_thread::sleep_for(std::chrono::microseconds(200));
+            continue;
+        }
+        // Ate dois trechos contiguos, por causa da volta do buffer. Depois
+        // de uma escrita curta os registros so sao descartados, para que
+        // record() nunca fique esperando espaco.
+        while (t < h) {
+            uint64_t start = t & mask;
+            uint64_t count = std::min<uint64_t>(h - t, buffer.size() - start);
+            if (!failed.load(std::memory_order_relaxed) &&
+                std::fwrite(&buffer[start], sizeof(TraceRecord), count, file) != count)
+                failed.store(true, std::memory_order_release);
+            t += count;
+        }
+        tail.store(t, std::memory_order_release);
+    }
+}
+
+void TedTrace::finish() {
+    if (drainer.joinable()) {
+        stopping.store(true, std::memory_order_release);
+        drainer.join();
+    }
+    if (file) {
+        if (std::fclose(file) != 0) failed.store(true, std::memory_order_release);
+        file = nullptr;
+    }
+}
+
+void decodeTrace(const std::string& tracePath, const std::string& outDir) {
+    std::ifstream in(tracePath, std::ios::binary);
+    if (!in) throw std::runtime_error("nao foi possivel abrir " + tracePath);
+    auto readU32 = [&]() {
+        uint32_t v = 0;
+        if (!in.read(reinterpret_cast<char*>(&v), sizeof v)) throw std::runtime_error("rastro truncado");
+        return v;
+    };
+    char magic[8];
+    if (!in.read(magic, sizeof magic) || std::memcmp(magic, traceMagic, sizeof magic) != 0)
+        throw std::runtime_error(tracePath + " nao eh um rastro TED");
+    if (readU32() != traceVersion) throw std::runtime_error("versao de rastro nao suportada");
+    readU32(); // sampleEvery
+    bool treedistOnly = readU32() & 1;
+    std::vector<std::string> labels[2];
+    for (auto& list : labels) {
+        list.resize(readU32());
+        for (auto& s : list) {
+            s.resize(readU32());
+            if (!in.read(s.data(), s.size())) throw std::runtime_error("rastro truncado");
+        }
+    }
+    auto label = [&](int tree, int idx) -> const std::string& {
+        if (idx < 0 || idx >= (int)labels[tree].size()) throw std::runtime_error("indice fora das arvores no rastro");
+        return labels[tree][idx];
+    };
+
+    std::filesystem::create_directories(outDir);
+    std::ofstream logFileAll(outDir + "/forestdist.log", std::ios::out | std::ios::trunc);
+    std::ofstream logFileMain(outDir + "/treedist.log", std::ios::out | std::ios::trunc);
+    static const char* const forestOp[] = {"match", "sub", "del", "ins", "tree"};
+    static const char* const chosenOp[] = {"match", "substituicao", "delecao", "insercao", "tree"};
+
+    TraceRecord r;
+    while (in.read(reinterpret_cast<char*>(&r), sizeof r)) {
+        int op = std::min<int>((int)r.op, 4);
+        switch (r.kind) {
+        case TraceKind::InitDel:
+            logFileAll << "log: forestdist[" << r.di << "][" << r.dj << "] = " << r.value
+                       << " (delecao de T1[" << label(0, r.di - 1) << "])\n";
+            break;
+        case TraceKind::InitIns:
+            logFileAll << "log: forestdist[" << r.di << "][" << r.dj << "] = " << r.value
+                       << " (insercao de T2[" << label(1, r.dj - 1) << "])\n";
+            break;
+        case TraceKind::ForestSub: {
+            const std::string& l1 = label(0, r.di - 1);
+            const std::string& l2 = label(1, r.dj - 1);
+            logFileMain << "treedist[" << r.di - 1 << "][" << r.dj - 1 << "] = " << r.value
+                        << " | op: " << forestOp[op] << " (T1[" << l1 << "] x T2[" << l2 << "])\n";
+            if (!treedistOnly)
+                logFileAll << "log: forestdist[" << r.di << "][" << r.dj << "] = " << r.value
+                           << " | del: " << r.del << ", ins: " << r.ins << ", sub: " << r.sub
+                           << " | op: " << chosenOp[op] << " (T1[" << l1 << "] x T2[" << l2 << "])\n";
+            break;
+        }
+        case TraceKind::ForestTree:
+            logFileAll << "log: forestdist[" << r.di << "][" << r.dj << "] = " << r.value
+                       << " | del: " << r.del << ", ins: " << r.ins << ", tree: " << r.sub
+                       << " | op: " << chosenOp[op] << "\n";
+            break;
+        default:
+            throw std::runtime_error("registro de rastro invalido");
+        }
+    }
+}
@@ -0,0 +1,101 @@
+#ifndef TREE_TRACE_H
+#define TREE_TRACE_H
+
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Rastro binario da programacao dinamica do Zhang-Shasha. Cada celula vira
+// um registro de tamanho fixo, gravado em um buffer circular que uma thread
+// de fundo descarrega no arquivo. O texto legivel (forestdist.log e
+// treedist.log) eh gerado depois, fora do algoritmo, por decodeTrace.
+
+enum class TraceKind : uint8_t {
+    InitDel,    // borda da floresta: delecao de T1[di-1]
+    InitIns,    // borda da floresta: insercao de T2[dj-1]
+    ForestSub,  // par de subarvores completas: tambem eh uma celula de treedist
+    ForestTree  // caso "tree": subflorestas
+};
+
+enum class TraceOp : uint8_t { Match, Sub, Del, Ins, Tree };
+
+struct TraceRecord {
+    TraceKind kind;
+    TraceOp op;
+    uint16_t reserved;
+    int32_t di, dj;
+    int32_t value;
+    int32_t del, ins, sub; // custos candidatos (sub = tree no caso ForestTree)
+};
+
+struct TraceOptions {
+    std::string path = "logs/ted.trace";
+    int sampleEvery = 1;        // grava 1 a cada k registros elegiveis
+    bool treedistOnly = false;  // grava so as celulas de treedist (ForestSub)
+    size_t bufferRecords = 1 << 16; // capacidade do buffer circular (potencia de 2)
+};
+
+class TedTrace {
+public:
+    explicit TedTrace(TraceOptions options = {});
+    ~TedTrace();
+
+    TedTrace(const TedTrace&) = delete;
+    TedTrace& operator=(const TedTrace&) = delete;
+
+    // Grava o cabecalho (rotulos em pos-ordem) e inicia a thread de descarga.
+    // Depois de finish() o mesmo objeto pode comecar um novo rastro; os
+    // contadores recomecam do zero. Chamar begin com um rastro ativo lanca
+    // std::runtime_error.
+    void begin(const std::vector<std::string>& labels1, const std::vector<std::string>& labels2);
+
+    void record(TraceKind kind, TraceOp op, int di, int dj, int value, int del = 0, int ins = 0, int sub = 0) {
+        if (options.treedistOnly && kind != TraceKind::ForestSub) return;
+        if (++sampleCounter < options.sampleEvery) return;
+        sampleCounter = 0;
+        push(TraceRecord{kind, op, 0, di, dj, value, del, ins, sub});
+    }
+
+    // Espera o buffer esvaziar, encerra a thread e fecha o arquivo. Um erro
+    // de escrita ou no fclose nao lanca (finish roda no destrutor): confira ok().
+    void finish();
+
+    uint64_t recorded() const { return head.load(std::memory_order_relaxed); }
+    uint64_t stalls() const { return stallCount; } // vezes que o buffer estava cheio
+    bool ok() const { return !failed.load(std::memory_order_acquire); } // false: rastro incompleto
+
+private:
+    void push(const TraceRecord& rec) {
+        uint64_t h = head.load(std::memory_order_relaxed);
+        if (h - tail.load(std::memory_order_acquire) >= buffer.size()) {
+            ++stallCount; // um evento por buffer cheio, nao por volta de espera
+            while (h - tail.load(std::memory_order_acquire) >= buffer.size())
+                std::this_thread::yield();
+        }
+        buffer[h & mask] = rec;
+        head.store(h + 1, std::memory_order_release);
+    }
+
+    void drainLoop();
+
+    TraceOptions options;
+    std::FILE* file = nullptr;
+    std::vector<TraceRecord> buffer;
+    uint64_t mask = 0;
+    std::atomic<uint64_t> head{0}, tail{0};
+    std::atomic<bool> stopping{false};
+    std::atomic<bool> failed{false}; // escrita curta ou erro no fclose
+    std::thread drainer;
+    int sampleCounter = 0;
+    uint64_t stallCount = 0;
+};
+
+// Converte um rastro binario nos logs de texto (mesmo formato de antes) em
+// outDir/forestdist.log e outDir/treedist.log. Lanca std::runtime_error se o
+// arquivo nao for um rastro valido.
+void decodeTrace(const std::string& tracePath, const std::string& outDir);
+
+#endif
@@ -1,10 +1,16 @@
+// Compilar com: g++ -O2 -std=c++17 -pthread Questao01.cpp
 #include <iostream>
 #include <vector>
-#include <map>
 #include <list>
-#include <cstdlib>
-#include <ctime>
+#include <string>
+#include <chrono>
+#include <random>
 #include <algorithm>
+#include <stdexcept>
+#include "csr_graph.hpp"
+#include "edge_classification.hpp"
+#include "parallel_scc.hpp"
+#include "graph_generators.hpp"
 
 using namespace std;
 
@@ -12,52 +18,24 @@ using namespace std;
 class Graph
 {
 private:
-    int vertices, edges, timeCounter;
+    int vertices, edges;
     vector<list<int>> adjacencyList;
-    vector<int> discoveryTime, finishTime;
-    vector<bool> visited;
-    map<pair<int, int>, string> edgeTypes;
 
-    void DFSVisit(int vertex)
+    CSRGraph toCSR() const
     {
-        visited[vertex] = true;
-        discoveryTime[vertex] = ++timeCounter;
-
-        for (int neighbor : adjacencyList[vertex])
-        {
-            if (!visited[neighbor])
-            {
-                edgeTypes[{vertex, neighbor}] = "tree";
-                DFSVisit(neighbor);
-            }
-            else
-            {
-                if (discoveryTime[neighbor] < discoveryTime[vertex] && finishTime[neighbor] == -1)
-                {
-                    edgeTypes[{vertex, neighbor}] = "back";
-                }
-                else if (discoveryTime[vertex] < discoveryTime[neighbor] && finishTime[neighbor] != -1)
-                {
-                    edgeTypes[{vertex, neighbor}] = "forward";
-                }
-                else if (discoveryTime[neighbor] < discoveryTime[vertex] && finishTime[neighbor] != -1)
-                {
-                    edgeTypes[{vertex, neighbor}] = "cross";
-                }
-            }
-        }
-
-        finishTime[vertex] = ++timeCounter;
+        vector<pair<int, int>> edgeList;
+        edgeList.reserve(edges);
+        for (int v = 0; v < vertices; ++v)
+            for (int neighbor : adjacencyList[v])
+                edgeList.push_back({v, neighbor});
+        return CSRGraph::fromEdges(vertices, edgeList);
     }
 
 public:
     Graph(int vertices)
-        : vertices(vertices), edges(0), timeCounter(0)
+        : vertices(vertices), edges(0)
     {
         adjacencyList.resize(vertices);
-        discoveryTime.assign(vertices, -1);
-        finishTime.assign(vertices, -1);
-        visited.assign(vertices, false);
     }
 
     void addEdge(int origin, int destination)
@@ -84,60 +62,190 @@ public:
         }
     }
 
-    void generateRandomGraph()
+    void generateRandomGraph(int edgeCount, uint64_t seed)
     {
-        srand(time(nullptr));
-        edges = rand() % 37 + 9;
-
-        for (int i = 0; i < edges; ++i)
+        CSRGraph graph = generateGnm(vertices, edgeCount, seed);
+        for (int v = 0; v < vertices; ++v)
         {
-            int origin, destination;
-            do
-            {
-                origin = rand() % vertices;
-                destination = rand() % vertices;
-            } while (origin == destination || find(adjacencyList[origin].begin(), adjacencyList[origin].end(), destination) != adjacencyList[origin].end());
-
-            adjacencyList[origin].push_back(destination);
+            adjacencyList[v].assign(graph.targets.begin() + graph.begin(v), graph.targets.begin() + graph.end(v));
         }
+        edges = (int)graph.edgeCount();
     }
 
     void performDFS()
     {
-        for (int i = 0; i < vertices; ++i)
+        CSRGraph graph = toCSR();
+        SCCResult scc;
+        EdgeClassification result = classifyEdges(graph, &scc);
+
+        cout << "\nEdge Classification:\n" << flush;
+        writeEdgeClassification(stdout, graph, result.edgeType);
+        for (int t = 0; t < 4; ++t)
         {
-            if (!visited[i])
-            {
-                DFSVisit(i);
-            }
+            cout << edgeTypeNames[t] << ": " << result.counts[t] << "\n";
         }
 
-        cout << "\nEdge Classification:\n";
-        for (const auto &[edge, type] : edgeTypes)
+        cout << "\nStrongly connected components: " << scc.componentCount
+             << (scc.hasCycle ? " (graph has a cycle)" : " (graph is acyclic)") << "\n";
+        for (int v = 0; v < vertices; ++v)
         {
-            cout << "Edge (" << edge.first << ", " << edge.second << "): " << type << endl;
+            cout << "Vertex " << v << ": component " << scc.component[v] << "\n";
         }
+        cout << "Condensation DAG edges: " << scc.condensation.edgeCount() << "\nTopological order:";
+        for (int c : scc.topologicalOrder)
+        {
+            cout << " " << c;
+        }
+        cout << "\n";
     }
 };
 
-int main()
+// Grafo aleatório com n vértices e m arestas, só para medir a classificação:
+// G(n,m) com m arestas distintas, R-MAT ou DAG com arestas de retorno. A
+// saída por aresta vai para um arquivo opcional.
+void benchmarkEdgeClassification()
 {
-    int vertexCount = 10;
-    Graph graph(vertexCount);
+    int n, model;
+    long long m;
+    double backEdgeRatio = 0;
+    string outPath;
+    cout << "Model (1. G(n,m)  2. R-MAT  3. DAG with back edges): ";
+    cin >> model;
+    cout << "Enter the number of vertices and edges: ";
+    cin >> n >> m;
+    if (model == 3)
+    {
+        cout << "Back edge ratio (0 to 1): ";
+        cin >> backEdgeRatio;
+    }
+    cout << "Output file for the edge list ('-' to skip): ";
+    cin >> outPath;
+
+    auto start = chrono::steady_clock::now();
+    CSRGraph graph;
+    if (model == 2)
+    {
+        int scale = 0;
+        while ((1 << scale) < n)
+            scale++;
+        graph = generateRMAT(scale, m, 42);
+    }
+    else if (model == 3)
+    {
+        graph = generateDAGWithBackEdges(n, m, backEdgeRatio, 42);
+    }
+    else
+    {
+        graph = generateGnm(n, m, 42);
+    }
+    auto built = chrono::steady_clock::now();
+    SCCResult scc;
+    EdgeClassification result = classifyEdges(graph, &scc);
+    auto classified = chrono::steady_clock::now();
+
+    cout << "Vertices: " << graph.vertices << ", distinct edges: " << graph.edgeCount() << "\n";
+    cout << "Generation + CSR build: " << chrono::duration<double>(built - start).count() << " s\n";
+    cout << "Classification + SCC: " << chrono::duration<double>(classified - built).count() << " s\n";
+    for (int t = 0; t < 4; ++t)
+        cout << edgeTypeNames[t] << ": " << result.counts[t] << "\n";
+    cout << "Components: " << scc.componentCount << ", condensation edges: " << scc.condensation.edgeCount()
+         << (scc.hasCycle ? ", cyclic\n" : ", acyclic\n");
+
+    if (outPath != "-")
+    {
+        FILE *out = fopen(outPath.c_str(), "w");
+        if (!out)
+        {
+            cout << "Could not open " << outPath << "\n";
+            return;
+        }
+        auto writeStart = chrono::steady_clock::now();
+        writeEdgeClassification(out, graph, result.edgeType);
+        fclose(out);
+        cout << "Write: " << chrono::duration<double>(chrono::steady_clock::now() - writeStart).count() << " s\n";
+    }
+}
+
+void benchmarkParallelSCC()
+{
+    int scale, edgeFactor, maxThreads;
+    cout << "Enter the R-MAT scale (2^scale vertices), edge factor and max threads: ";
+    cin >> scale >> edgeFactor >> maxThreads;
+
+    int n = 1 << scale;
+    CSRGraph graph = generateRMAT(scale, (long long)n * edgeFactor, 42);
+    cout << "Vertices: " << n << ", edges: " << graph.edgeCount()
+         << ", hardware threads: " << thread::hardware_concurrency() << "\n";
+
+    auto start = chrono::steady_clock::now();
+    SCCResult sequential;
+    classifyEdges(graph, &sequential);
+    double baseTime = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    cout << "Sequential Tarjan: " << baseTime << " s, components: " << sequential.componentCount << "\n";
+
+    for (int threads = 1; threads <= maxThreads; threads *= 2)
+    {
+        ParallelSCCStats stats;
+        start = chrono::steady_clock::now();
+        SCCResult parallel = parallelStronglyConnectedComponents(graph, threads, &stats);
+        double elapsed = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        cout << "Threads " << threads << ": " << elapsed << " s (speedup " << baseTime / elapsed << "x)"
+             << ", trimmed " << stats.trimmed << ", pivot SCC " << stats.pivotComponent
+             << ", coloring rounds " << stats.coloringRounds
+             << (parallel.component == sequential.component ? ", ids match\n" : ", IDS DIFFER\n");
+    }
+}
 
+int runMenu()
+{
     int option;
-    cout << "Choose an option:\n1. Create a specific graph\n2. Generate a random graph\n";
+    cout << "Choose an option:\n1. Create a specific graph\n2. Generate a random graph\n3. Benchmark edge classification on a large random graph\n4. Benchmark parallel SCC thread scaling\n";
     cin >> option;
 
+    if (option == 3)
+    {
+        benchmarkEdgeClassification();
+        return 0;
+    }
+    if (option == 4)
+    {
+        benchmarkParallelSCC();
+        return 0;
+    }
+
+    int vertexCount;
+    cout << "Enter the number of vertices: ";
+    cin >> vertexCount;
+    Graph graph(vertexCount);
+
     if (option == 1)
     {
         graph.createSpecificGraph();
     }
     else if (option == 2)
     {
-        graph.generateRandomGraph();
+        int edgeCount;
+        uint64_t seed;
+        cout << "Enter the number of edges and the seed: ";
+        cin >> edgeCount >> seed;
+        graph.generateRandomGraph(edgeCount, seed);
     }
 
     graph.performDFS();
     return 0;
 }
+
+// Entradas fora do alcance dos geradores (mais arestas do que cabem no
+// grafo, por exemplo) viram uma mensagem em vez de terminate.
+int main()
+{
+    try
+    {
+        return runMenu();
+    }
+    catch (const exception &e)
+    {
+        cerr << "Error: " << e.what() << "\n";
+        return 1;
+    }
+}
@@ -1,25 +1,46 @@
+// Compilar com: g++ -O2 -std=c++17 -pthread Questao02.cpp
 #include <iostream>
 #include <vector>
-#include <queue>
 #include <climits>
 #include <cstdlib> 
 #include <ctime>   
+#include <chrono>
+#include <random>
+#include <string>
+#include "bit_matrix.hpp"
+#include "csr_graph.hpp"
+#include "excentricity.hpp"
+#include "direction_bfs.hpp"
+#include "all_pairs.hpp"
+#include "hyperanf.hpp"
+#include "graph_generators.hpp"
 
 using namespace std;
 
 class Graph {
 private:
     int numVertices;
-    vector<vector<int>> adjMatrix;
+    BitMatrix adjMatrix; // um bit por celula, uma unica alocacao
+    CSRGraph adjacencyCache;
+    bool adjacencyValid = false;
 
 public:
-    Graph(int vertices) : numVertices(vertices) {
-        adjMatrix.resize(vertices, vector<int>(vertices, 0));
+    Graph(int vertices) : numVertices(vertices), adjMatrix(vertices) {
     }
 
     void addEdge(int u, int v) {
-        adjMatrix[u][v] = 1;
-        adjMatrix[v][u] = 1;
+        adjMatrix.set(u, v);
+        adjMatrix.set(v, u);
+        adjacencyValid = false;
+    }
+
+    // Lista CSR da matriz, refeita so depois de novas arestas.
+    const CSRGraph &adjacency() {
+        if (!adjacencyValid) {
+            adjacencyCache = toCSR();
+            adjacencyValid = true;
+        }
+        return adjacencyCache;
     }
 
     void generateRandomEdges(int maxEdges) {
@@ -29,36 +50,23 @@ public:
             int u = rand() % numVertices;
             int v = rand() % numVertices;
             
-            if (u != v && adjMatrix[u][v] == 0) {
+            if (u != v && !adjMatrix.test(u, v)) {
                 addEdge(u, v);
             }
         }
     }
 
     vector<int> bfs(int startVertex) {
-        vector<int> distances(numVertices, INT_MAX);
-        queue<int> q;
-
-        distances[startVertex] = 0;
-        q.push(startVertex);
-
-        while (!q.empty()) {
-            int currentVertex = q.front();
-            q.pop();
-
-            for (int i = 0; i < numVertices; ++i) {
-                if (adjMatrix[currentVertex][i] == 1 && distances[i] == INT_MAX) {
-                    distances[i] = distances[currentVertex] + 1;
-                    q.push(i);
-                }
-            }
-        }
-
+        vector<int> distances;
+        bitMatrixBfs(adjMatrix, startVertex, distances, INT_MAX);
         return distances;
     }
 
-    int findExcentricity(int vertex) {
-        vector<int> distances = bfs(vertex);
+    // BFS com otimizacao de direcao sobre a lista CSR; stats recebe as
+    // arestas inspecionadas e o tempo de cada nivel.
+    int findExcentricity(int vertex, BfsStats *stats = nullptr) {
+        vector<int> distances;
+        directionOptimizingBfs(adjacency(), vertex, distances, INT_MAX, stats);
         int excentricity = 0;
 
         for (int dist : distances) {
@@ -73,33 +81,305 @@ public:
     void printAdjMatrix() {
         for (int i = 0; i < numVertices; ++i) {
             for (int j = 0; j < numVertices; ++j) {
-                cout << adjMatrix[i][j] << " ";
+                cout << adjMatrix.test(i, j) << " ";
             }
             cout << endl;
         }
     }
 
+    CSRGraph toCSR() const {
+        vector<pair<int, int>> edges;
+        for (int u = 0; u < numVertices; ++u) {
+            const uint64_t *row = adjMatrix.row(u);
+            for (int k = 0; k < adjMatrix.rowWords(); ++k) {
+                for (uint64_t bits = row[k]; bits; bits &= bits - 1) {
+                    edges.push_back({u, k * 64 + __builtin_ctzll(bits)});
+                }
+            }
+        }
+        return CSRGraph::fromEdges(numVertices, edges);
+    }
+
+    // Todas as excentricidades de uma vez com MS-BFS sobre a lista CSR,
+    // em vez de uma BFS na matriz por vertice.
+    ExcentricityResult computeExcentricities() {
+        return msbfsExcentricities(adjacency());
+    }
+
     vector<int> findAllExcentricities() {
-        vector<int> excentricities(numVertices, 0);
+        return computeExcentricities().excentricities;
+    }
 
-        for (int vertex = 0; vertex < numVertices; ++vertex) {
-            vector<int> distances = bfs(vertex);
-            int maxDistance = 0;
+    // BFS de todas as origens em varias threads, com proximidade, distancia
+    // total e histograma de saltos na mesma passada.
+    AllPairsResult computeAllPairsStatistics(int threads) {
+        return allPairsStatistics(adjacency(), threads);
+    }
 
-            for (int dist : distances) {
-                if (dist != INT_MAX) {
-                    maxDistance = max(maxDistance, dist);
-                }
+    // Funcao de vizinhanca aproximada (HyperANF), para grafos grandes demais
+    // para BFS de todas as origens.
+    HyperAnfResult estimateNeighborhoodFunction(int log2Registers) {
+        return hyperAnf(adjacency(), log2Registers);
+    }
+
+    // Diametro, raio, centro e periferia por refinamento de limites, sem
+    // calcular todas as excentricidades.
+    ExtremesResult findExtremes(bool withSets = true) {
+        return boundingExtremes(adjacency(), withSets);
+    }
+
+};
+
+// BFS com fila sobre CSR; devolve a excentricidade da origem.
+int csrBfs(const CSRGraph &graph, int start, vector<int> &distances, vector<int> &queue) {
+    distances.assign(graph.vertices, INT_MAX);
+    int head = 0, tail = 0;
+    distances[start] = 0;
+    queue[tail++] = start;
+    while (head < tail) {
+        int v = queue[head++];
+        for (int64_t e = graph.begin(v); e < graph.end(v); ++e) {
+            int w = graph.targets[e];
+            if (distances[w] == INT_MAX) {
+                distances[w] = distances[v] + 1;
+                queue[tail++] = w;
             }
-            excentricities[vertex] = maxDistance;
         }
+    }
+    return distances[queue[tail - 1]];
+}
 
-        return excentricities;
+// Benchmark em CSR gerado direto (sem matriz): MS-BFS contra BFS com fila
+// por origem, esta estimada a partir de uma amostra de origens.
+void benchmarkExcentricities(int n, long long m) {
+    mt19937_64 rng(42);
+    uniform_int_distribution<int> pick(0, n - 1);
+    vector<pair<int, int>> edges(m);
+    for (auto &e : edges) {
+        e = {pick(rng), pick(rng)};
     }
+    CSRGraph graph = CSRGraph::fromUndirectedEdges(n, edges);
+    cout << "Vertices: " << n << ", arestas (dois sentidos): " << graph.edgeCount() << endl;
 
-};
+    auto start = chrono::steady_clock::now();
+    ExcentricityResult result = msbfsExcentricities(graph);
+    double msbfsTime = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    cout << "MS-BFS: " << msbfsTime << " s, diametro " << result.diameter << ", raio " << result.radius << endl;
+
+    int sample = min(n, 256);
+    vector<int> distances, queue(n);
+    int mismatches = 0;
+    start = chrono::steady_clock::now();
+    for (int s = 0; s < sample; ++s) {
+        int ecc = csrBfs(graph, s, distances, queue);
+        mismatches += ecc != result.excentricities[s];
+    }
+    double bfsTime = chrono::duration<double>(chrono::steady_clock::now() - start).count() * n / sample;
+    cout << "BFS por origem (estimado): " << bfsTime << " s, speedup " << bfsTime / msbfsTime
+         << "x, divergencias na amostra: " << mismatches << endl;
+}
+
+// Grafo power-law (R-MAT simetrizado): limites de excentricidade contra
+// MS-BFS, que so roda quando o grafo e pequeno o bastante.
+void benchmarkExtremes(int scale, int edgeFactor) {
+    CSRGraph directed = generateRMAT(scale, (long long)edgeFactor << scale, 42);
+    CSRGraph graph = CSRGraph::fromUndirectedEdges(directed.vertices, directed.edgeList());
+    cout << "Vertices: " << graph.vertices << ", arestas (dois sentidos): " << graph.edgeCount() << endl;
+
+    auto start = chrono::steady_clock::now();
+    ExtremesResult onlyValues = boundingExtremes(graph, false);
+    double valuesTime = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    cout << "Diametro e raio: " << onlyValues.diameter << ", " << onlyValues.radius << " com "
+         << onlyValues.bfsRuns << " BFS em " << valuesTime << " s" << endl;
+
+    start = chrono::steady_clock::now();
+    ExtremesResult withSets = boundingExtremes(graph, true);
+    double setsTime = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    cout << "Com centro (" << withSets.center.size() << ") e periferia (" << withSets.periphery.size()
+         << "): " << withSets.bfsRuns << " BFS em " << setsTime << " s" << endl;
+
+    if (graph.vertices <= (1 << 16)) {
+        start = chrono::steady_clock::now();
+        ExcentricityResult all = msbfsExcentricities(graph);
+        double allTime = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        bool same = all.diameter == withSets.diameter && all.radius == withSets.radius;
+        cout << "MS-BFS de todos os vertices: " << allTime << " s, " << (same ? "mesmos valores" : "VALORES DIFERENTES") << endl;
+    }
+}
+
+// Matriz de bits contra lista CSR para graus medios crescentes: a matriz
+// custa O(V / 64) palavras por vertice retirado da fila, a lista O(grau).
+void benchmarkCrossover(int n) {
+    mt19937_64 rng(42);
+    uniform_int_distribution<int> pick(0, n - 1);
+    int sources = 32;
+    vector<int> distances, expected, queue(n);
+    cout << "grau medio | matriz (ms/BFS) | CSR (ms/BFS) | mais rapido" << endl;
+    for (long long degree = 2; degree <= n / 2; degree *= 4) {
+        BitMatrix matrix(n);
+        vector<pair<int, int>> edges;
+        for (long long i = 0; i < (long long)n * degree / 2; ++i) {
+            int u = pick(rng), v = pick(rng);
+            if (u != v) {
+                edges.push_back({u, v});
+                matrix.set(u, v);
+                matrix.set(v, u);
+            }
+        }
+        CSRGraph graph = CSRGraph::fromUndirectedEdges(n, edges);
+
+        double matrixTime = 0, csrTime = 0;
+        bool same = true;
+        for (int s = 0; s < sources; ++s) {
+            auto t0 = chrono::steady_clock::now();
+            bitMatrixBfs(matrix, s, distances, INT_MAX);
+            auto t1 = chrono::steady_clock::now();
+            csrBfs(graph, s, expected, queue);
+            auto t2 = chrono::steady_clock::now();
+            matrixTime += chrono::duration<double, milli>(t1 - t0).count();
+            csrTime += chrono::duration<double, milli>(t2 - t1).count();
+            same = same && distances == expected;
+        }
+        cout << (double)graph.edgeCount() / n << " | " << matrixTime / sources << " | " << csrTime / sources
+             << " | " << (matrixTime < csrTime ? "matriz" : "CSR") << (same ? "" : " (DISTANCIAS DIFERENTES)") << endl;
+    }
+}
+
+// BFS top-down contra a com otimizacao de direcao no mesmo grafo
+// power-law, a partir do vertice de maior grau, com a tabela por nivel.
+void benchmarkDirectionOptimizing(int scale, int edgeFactor) {
+    CSRGraph directed = generateRMAT(scale, (long long)edgeFactor << scale, 42);
+    CSRGraph graph = CSRGraph::fromUndirectedEdges(directed.vertices, directed.edgeList());
+    int source = 0;
+    for (int v = 1; v < graph.vertices; ++v) {
+        if (graph.outDegree(v) > graph.outDegree(source)) {
+            source = v;
+        }
+    }
+    cout << "Vertices: " << graph.vertices << ", arestas (dois sentidos): " << graph.edgeCount()
+         << ", origem " << source << endl;
+
+    vector<int> topDownDistances, distances;
+    for (int mode = 0; mode < 2; ++mode) {
+        DirectionParams params;
+        params.allowBottomUp = mode == 1;
+        BfsStats stats;
+        directionOptimizingBfs(graph, source, mode == 0 ? topDownDistances : distances, INT_MAX, &stats, params);
+        double total = 0;
+        cout << (mode == 0 ? "\nSo top-down:" : "\nCom otimizacao de direcao:") << endl;
+        for (const BfsLevelStats &level : stats.levels) {
+            cout << "  nivel " << level.level << (level.bottomUp ? " bottom-up" : " top-down ")
+                 << " fronteira " << level.frontier << ", arestas " << level.edgesInspected << ", "
+                 << level.milliseconds << " ms" << endl;
+            total += level.milliseconds;
+        }
+        cout << "  total: " << stats.edgesInspected << " arestas, " << total << " ms" << endl;
+    }
+    cout << (distances == topDownDistances ? "\nMesmas distancias" : "\nDISTANCIAS DIFERENTES") << endl;
+}
+
+// Escalabilidade da BFS de todas as origens por numero de threads.
+void benchmarkAllPairs(int n, long long m, int maxThreads) {
+    mt19937_64 rng(42);
+    uniform_int_distribution<int> pick(0, n - 1);
+    vector<pair<int, int>> edges(m);
+    for (auto &e : edges) {
+        e = {pick(rng), pick(rng)};
+    }
+    CSRGraph graph = CSRGraph::fromUndirectedEdges(n, edges);
+    cout << "Vertices: " << n << ", arestas (dois sentidos): " << graph.edgeCount()
+         << ", threads de hardware: " << thread::hardware_concurrency() << endl;
+
+    ExcentricityResult reference = msbfsExcentricities(graph);
+    double baseTime = 0;
+    for (int threads = 1; threads <= maxThreads; threads *= 2) {
+        auto start = chrono::steady_clock::now();
+        AllPairsResult result = allPairsStatistics(graph, threads);
+        double elapsed = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        if (threads == 1) {
+            baseTime = elapsed;
+        }
+        cout << "Threads " << threads << ": " << elapsed << " s (speedup " << baseTime / elapsed << "x)"
+             << (result.excentricities == reference.excentricities ? "" : " EXCENTRICIDADES DIFERENTES") << endl;
+        if (threads * 2 > maxThreads) {
+            cout << "Histograma de saltos:";
+            for (size_t h = 0; h < result.hopHistogram.size(); ++h) {
+                cout << " " << h << ":" << result.hopHistogram[h];
+            }
+            int best = int(max_element(result.closeness.begin(), result.closeness.end()) - result.closeness.begin());
+            cout << "\nMaior proximidade: vertice " << best << " (" << result.closeness[best]
+                 << ", distancia total " << result.farness[best] << ")" << endl;
+        }
+    }
+}
+
+// HyperANF em um grafo power-law; o erro mostrado e um desvio padrao
+// (relativeStdError * N(h)). Os contadores compartilham a funcao de hash,
+// entao os erros dos vertices nao se cancelam na soma: N(h) tem o mesmo erro
+// relativo de um contador. Em grafos pequenos compara com o valor exato.
+void benchmarkHyperAnf(int scale, int edgeFactor, int log2Registers) {
+    CSRGraph directed = generateRMAT(scale, (long long)edgeFactor << scale, 42);
+    CSRGraph graph = CSRGraph::fromUndirectedEdges(directed.vertices, directed.edgeList());
+    cout << "Vertices: " << graph.vertices << ", arestas (dois sentidos): " << graph.edgeCount()
+         << ", registradores por contador: " << (1 << log2Registers) << endl;
+
+    auto start = chrono::steady_clock::now();
+    HyperAnfResult result = hyperAnf(graph, log2Registers);
+    double elapsed = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    cout << "HyperANF: " << elapsed << " s, " << result.iterations << " iteracoes, erro relativo +-"
+         << 100 * result.relativeStdError << "%" << endl;
+
+    bool exact = graph.vertices <= (1 << 14);
+    AllPairsResult reference;
+    if (exact) {
+        reference = allPairsStatistics(graph, (int)max(1u, thread::hardware_concurrency()));
+    }
+    double cumulative = 0;
+    for (size_t h = 0; h < result.neighborhoodFunction.size(); ++h) {
+        double value = result.neighborhoodFunction[h];
+        cout << "N(" << h << ") = " << value << " +- " << value * result.relativeStdError;
+        if (exact) {
+            cumulative += h < reference.hopHistogram.size() ? reference.hopHistogram[h] : 0;
+            cout << " (exato " << cumulative << ")";
+        }
+        cout << endl;
+    }
+    cout << "Diametro efetivo (90%): " << result.effectiveDiameter << endl;
+    if (exact) {
+        double error = 0;
+        for (int v = 0; v < graph.vertices; ++v) {
+            error += abs(result.excentricityEstimates[v] - reference.excentricities[v]);
+        }
+        cout << "Erro medio absoluto das excentricidades estimadas: " << error / graph.vertices << endl;
+    }
+}
+
+int main(int argc, char **argv) {
+    if (argc == 4 && string(argv[1]) == "bench") {
+        benchmarkExcentricities(atoi(argv[2]), atoll(argv[3]));
+        return 0;
+    }
+    if (argc == 3 && string(argv[1]) == "crossover") {
+        benchmarkCrossover(atoi(argv[2]));
+        return 0;
+    }
+    if (argc == 5 && string(argv[1]) == "allpairs") {
+        benchmarkAllPairs(atoi(argv[2]), atoll(argv[3]), atoi(argv[4]));
+        return 0;
+    }
+    if (argc == 5 && string(argv[1]) == "hyperanf") {
+        benchmarkHyperAnf(atoi(argv[2]), atoi(argv[3]), atoi(argv[4]));
+        return 0;
+    }
+    if (argc == 4 && string(argv[1]) == "direction") {
+        benchmarkDirectionOptimizing(atoi(argv[2]), atoi(argv[3]));
+        return 0;
+    }
+    if (argc == 4 && string(argv[1]) == "extremes") {
+        benchmarkExtremes(atoi(argv[2]), atoi(argv[3]));
+        return 0;
+    }
 
-int main() {
     int numVertices = 6;
     int maxEdges = 10;
 
@@ -113,11 +393,30 @@ int main() {
     int excentricity = graph.findExcentricity(vertex);
     cout << "\nA excentricidade do vertice " << vertex << " eh " << excentricity << endl;
 
-    vector<int> excentricities = graph.findAllExcentricities();
+    ExcentricityResult all = graph.computeExcentricities();
+    vector<int> &excentricities = all.excentricities;
     cout << "\nExcentricidade de cada vertice:\n" << endl;
     for (int i = 0; i < excentricities.size(); ++i) {
         cout << "Vertice " << i << ": " << excentricities[i] << endl;
     }
+    cout << "\nDiametro: " << all.diameter << ", raio: " << all.radius << endl;
+
+    ExtremesResult extremes = graph.findExtremes();
+    cout << "Centro:";
+    for (int v : extremes.center) {
+        cout << " " << v;
+    }
+    cout << "\nPeriferia:";
+    for (int v : extremes.periphery) {
+        cout << " " << v;
+    }
+    cout << "\n(" << extremes.bfsRuns << " BFS pelo refinamento de limites)" << endl;
+
+    AllPairsResult pairs = graph.computeAllPairsStatistics(2);
+    cout << "\nProximidade de cada vertice:\n" << endl;
+    for (int i = 0; i < numVertices; ++i) {
+        cout << "Vertice " << i << ": " << pairs.closeness[i] << " (distancia total " << pairs.farness[i] << ")" << endl;
+    }
 
     return 0;
 }
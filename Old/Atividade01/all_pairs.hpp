@@ -0,0 +1,149 @@
+#ifndef ALL_PAIRS_HPP
+#define ALL_PAIRS_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "csr_graph.hpp"
+
+using namespace std;
+
+// Distribuição de tarefas com roubo: cada thread recebe uma faixa contígua
+// de índices e consome do início dela; quando acaba, rouba a metade final
+// da faixa de outra thread. As faixas são pequenas estruturas protegidas
+// por mutex, então o custo de sincronização é uma trava por bloco.
+class WorkStealingRanges {
+private:
+    struct Range {
+        mutex lock;
+        int begin = 0, end = 0;
+    };
+    vector<Range> ranges;
+    int block;
+
+public:
+    WorkStealingRanges(int count, int threads, int blockSize) : ranges(threads), block(blockSize) {
+        for (int t = 0; t < threads; ++t) {
+            ranges[t].begin = (int)((int64_t)count * t / threads);
+            ranges[t].end = (int)((int64_t)count * (t + 1) / threads);
+        }
+    }
+
+    // Próximo bloco [first, last) para a thread t; false quando acabou tudo.
+    bool next(int t, int &first, int &last) {
+        {
+            lock_guard<mutex> guard(ranges[t].lock);
+            if (ranges[t].begin < ranges[t].end) {
+                first = ranges[t].begin;
+                last = min(ranges[t].end, first + block);
+                ranges[t].begin = last;
+                return true;
+            }
+        }
+        for (int k = 1; k < (int)ranges.size(); ++k) {
+            Range &victim = ranges[(t + k) % ranges.size()];
+            lock_guard<mutex> guard(victim.lock);
+            int left = victim.end - victim.begin;
+            if (left <= 0)
+                continue;
+            int stolen = max(1, left / 2);
+            first = victim.end - stolen;
+            last = victim.end;
+            victim.end = first;
+            if (last - first > block) {
+                // Guarda o excesso na própria faixa para os próximos pedidos.
+                lock_guard<mutex> own(ranges[t].lock);
+                ranges[t].begin = first + block;
+                ranges[t].end = last;
+                last = first + block;
+            }
+            return true;
+        }
+        return false;
+    }
+};
+
+struct AllPairsResult {
+    vector<int> excentricities;
+    vector<int64_t> farness;    // soma das distâncias aos vértices alcançados
+    vector<double> closeness;   // normalizada de Wasserman-Faust, 0 se isolado
+    vector<int64_t> hopHistogram; // hopHistogram[h] = pares (s, t) com d = h
+    int diameter = 0;
+    int radius = 0;
+};
+
+// BFS de todas as origens em paralelo sobre um grafo em CSR. Cada thread
+// reaproveita o mesmo vetor de distâncias e a mesma fila em todas as suas
+// origens: depois de cada BFS só os vértices que entraram na fila voltam a
+// -1, então o custo de limpeza é proporcional ao que foi tocado. Os
+// histogramas são por thread e somados no fim.
+inline AllPairsResult allPairsStatistics(const CSRGraph &g, int threads) {
+    int n = g.vertices;
+    threads = max(1, threads);
+    AllPairsResult r;
+    r.excentricities.assign(n, 0);
+    r.farness.assign(n, 0);
+    r.closeness.assign(n, 0.0);
+    if (n == 0)
+        return r;
+
+    WorkStealingRanges work(n, threads, 16);
+    vector<vector<int64_t>> histograms(threads);
+
+    auto worker = [&](int t) {
+        vector<int> distances(n, -1), queue(n);
+        vector<int64_t> &histogram = histograms[t];
+        int first, last;
+        while (work.next(t, first, last)) {
+            for (int s = first; s < last; ++s) {
+                int head = 0, tail = 0;
+                distances[s] = 0;
+                queue[tail++] = s;
+                int64_t sum = 0;
+                while (head < tail) {
+                    int v = queue[head++];
+                    int d = distances[v];
+                    sum += d;
+                    if (d >= (int)histogram.size())
+                        histogram.resize(d + 1, 0);
+                    histogram[d]++;
+                    for (int64_t e = g.begin(v); e < g.end(v); ++e) {
+                        int w = g.targets[e];
+                        if (distances[w] == -1) {
+                            distances[w] = d + 1;
+                            queue[tail++] = w;
+                        }
+                    }
+                }
+                r.excentricities[s] = distances[queue[tail - 1]];
+                r.farness[s] = sum;
+                // (k - 1) / farness escalado por (k - 1) / (n - 1), para que
+                // componentes pequenas não pareçam centrais.
+                r.closeness[s] = sum > 0 ? (double)(tail - 1) / sum * (tail - 1) / (n - 1) : 0.0;
+                for (int i = 0; i < tail; ++i)
+                    distances[queue[i]] = -1;
+            }
+        }
+    };
+
+    vector<thread> pool;
+    for (int t = 1; t < threads; ++t)
+        pool.emplace_back(worker, t);
+    worker(0);
+    for (auto &th : pool)
+        th.join();
+
+    for (auto &h : histograms) {
+        if (h.size() > r.hopHistogram.size())
+            r.hopHistogram.resize(h.size(), 0);
+        for (size_t d = 0; d < h.size(); ++d)
+            r.hopHistogram[d] += h[d];
+    }
+    r.diameter = *max_element(r.excentricities.begin(), r.excentricities.end());
+    r.radius = *min_element(r.excentricities.begin(), r.excentricities.end());
+    return r;
+}
+
+#endif
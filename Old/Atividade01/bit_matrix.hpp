@@ -0,0 +1,108 @@
+#ifndef BIT_MATRIX_HPP
+#define BIT_MATRIX_HPP
+
+#include <cstdint>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define BIT_MATRIX_X86 1
+#endif
+
+using namespace std;
+
+// Matriz de adjacência com um bit por célula, em uma única alocação. Cada
+// linha ocupa rowWords palavras de 64 bits, arredondado para múltiplo de 4
+// para que a linha inteira seja percorrida em blocos de 256 bits.
+class BitMatrix {
+private:
+    int n;
+    int words;
+    vector<uint64_t> bits;
+
+public:
+    BitMatrix(int vertices = 0) : n(vertices), words(((vertices + 255) / 256) * 4) {
+        bits.assign((size_t)n * words, 0);
+    }
+
+    int size() const { return n; }
+    int rowWords() const { return words; }
+
+    void set(int u, int v) { bits[(size_t)u * words + v / 64] |= 1ULL << (v % 64); }
+    bool test(int u, int v) const { return (bits[(size_t)u * words + v / 64] >> (v % 64)) & 1; }
+    const uint64_t *row(int u) const { return &bits[(size_t)u * words]; }
+};
+
+// fresh = row & ~visited; visited |= fresh. Devolve quantos bits são novos.
+// As duas versões fazem o mesmo; a AVX2 (só em x86) pula blocos de 256 bits
+// vazios com testz e só conta bits quando o bloco tem algo novo.
+inline int expandRowScalar(const uint64_t *row, uint64_t *visited, uint64_t *fresh, int words) {
+    int count = 0;
+    for (int k = 0; k < words; ++k) {
+        uint64_t f = row[k] & ~visited[k];
+        visited[k] |= f;
+        fresh[k] = f;
+        count += __builtin_popcountll(f);
+    }
+    return count;
+}
+
+#ifdef BIT_MATRIX_X86
+__attribute__((target("avx2,popcnt")))
+inline int expandRowAvx2(const uint64_t *row, uint64_t *visited, uint64_t *fresh, int words) {
+    int count = 0;
+    for (int k = 0; k < words; k += 4) {
+        __m256i r = _mm256_loadu_si256((const __m256i *)(row + k));
+        __m256i v = _mm256_loadu_si256((const __m256i *)(visited + k));
+        __m256i f = _mm256_andnot_si256(v, r);
+        _mm256_storeu_si256((__m256i *)(fresh + k), f);
+        if (_mm256_testz_si256(f, f))
+            continue;
+        _mm256_storeu_si256((__m256i *)(visited + k), _mm256_or_si256(v, f));
+        count += (int)(_mm_popcnt_u64(fresh[k]) + _mm_popcnt_u64(fresh[k + 1]) +
+                       _mm_popcnt_u64(fresh[k + 2]) + _mm_popcnt_u64(fresh[k + 3]));
+    }
+    return count;
+}
+#endif
+
+typedef int (*ExpandRowFn)(const uint64_t *, uint64_t *, uint64_t *, int);
+
+inline ExpandRowFn selectExpandRow() {
+#ifdef BIT_MATRIX_X86
+    static const ExpandRowFn fn = __builtin_cpu_supports("avx2") ? expandRowAvx2 : expandRowScalar;
+    return fn;
+#else
+    return expandRowScalar;
+#endif
+}
+
+// BFS sobre a matriz de bits: cada vértice retirado da fila expande a linha
+// inteira contra o conjunto visitado, 64 vizinhos por palavra, e só os bits
+// novos são extraídos com ctz. Distâncias inalcançáveis ficam em unreachable.
+inline void bitMatrixBfs(const BitMatrix &m, int start, vector<int> &distances, int unreachable) {
+    int n = m.size(), words = m.rowWords();
+    ExpandRowFn expand = selectExpandRow();
+    vector<uint64_t> visited(words, 0), fresh(words);
+    vector<int> queue(n);
+    distances.assign(n, unreachable);
+
+    int head = 0, tail = 0;
+    distances[start] = 0;
+    visited[start / 64] |= 1ULL << (start % 64);
+    queue[tail++] = start;
+    while (head < tail) {
+        int u = queue[head++];
+        if (expand(m.row(u), visited.data(), fresh.data(), words) == 0)
+            continue;
+        for (int k = 0; k < words; ++k) {
+            for (uint64_t f = fresh[k]; f; f &= f - 1) {
+                int v = k * 64 + __builtin_ctzll(f);
+                distances[v] = distances[u] + 1;
+                queue[tail++] = v;
+            }
+        }
+    }
+}
+
+#endif
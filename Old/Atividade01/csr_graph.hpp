@@ -0,0 +1,114 @@
+#ifndef CSR_GRAPH_HPP
+#define CSR_GRAPH_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+// Grafo dirigido em formato CSR (compressed sparse row): os vizinhos de v
+// ficam em targets[offsets[v] .. offsets[v + 1]). A posição de uma aresta em
+// targets é o seu id, usado para indexar arrays por aresta.
+struct CSRGraph
+{
+    int vertices = 0;
+    vector<int64_t> offsets; // tamanho vertices + 1
+    vector<int> targets;     // tamanho edgeCount()
+
+    int64_t edgeCount() const { return (int64_t)targets.size(); }
+    int64_t begin(int v) const { return offsets[v]; }
+    int64_t end(int v) const { return offsets[v + 1]; }
+    int outDegree(int v) const { return (int)(offsets[v + 1] - offsets[v]); }
+
+    // Monta o CSR a partir de uma lista de arestas, por contagem (O(V + E)).
+    // A ordem das arestas de cada vértice é a ordem da lista.
+    static CSRGraph fromEdges(int n, const vector<pair<int, int>> &edges)
+    {
+        CSRGraph g;
+        g.vertices = n;
+        g.offsets.assign(n + 1, 0);
+        for (const auto &e : edges)
+            g.offsets[e.first + 1]++;
+        for (int v = 0; v < n; ++v)
+            g.offsets[v + 1] += g.offsets[v];
+        g.targets.resize(edges.size());
+        vector<int64_t> cursor(g.offsets.begin(), g.offsets.end() - 1);
+        for (const auto &e : edges)
+            g.targets[cursor[e.first]++] = e.second;
+        return g;
+    }
+
+    // Grafo não dirigido: cada aresta entra nos dois sentidos; repetições e
+    // laços são removidos.
+    static CSRGraph fromUndirectedEdges(int n, const vector<pair<int, int>> &edges)
+    {
+        vector<pair<int, int>> both;
+        both.reserve(2 * edges.size());
+        for (const auto &e : edges)
+        {
+            both.push_back(e);
+            both.push_back({e.second, e.first});
+        }
+        CSRGraph g = fromEdges(n, both);
+        g.sortAndDeduplicate();
+        return g;
+    }
+
+    // Ordena os vizinhos de cada vértice e remove repetições (e laços, se
+    // pedido) com sort + unique linha a linha, compactando targets no lugar.
+    void sortAndDeduplicate(bool removeSelfLoops = true)
+    {
+        int64_t write = 0;
+        for (int v = 0; v < vertices; ++v)
+        {
+            int64_t b = offsets[v], e = offsets[v + 1];
+            sort(targets.begin() + b, targets.begin() + e);
+            int64_t rowStart = write;
+            for (int64_t i = b; i < e; ++i)
+            {
+                int w = targets[i];
+                if (removeSelfLoops && w == v)
+                    continue;
+                if (write > rowStart && targets[write - 1] == w)
+                    continue;
+                targets[write++] = w;
+            }
+            offsets[v] = rowStart;
+        }
+        offsets[vertices] = write;
+        targets.resize(write);
+        targets.shrink_to_fit();
+    }
+
+    vector<pair<int, int>> edgeList() const
+    {
+        vector<pair<int, int>> edges;
+        edges.reserve(targets.size());
+        for (int v = 0; v < vertices; ++v)
+            for (int64_t e = offsets[v]; e < offsets[v + 1]; ++e)
+                edges.push_back({v, targets[e]});
+        return edges;
+    }
+
+    // Grafo transposto (todas as arestas invertidas), também por contagem.
+    CSRGraph transpose() const
+    {
+        CSRGraph t;
+        t.vertices = vertices;
+        t.offsets.assign(vertices + 1, 0);
+        for (int w : targets)
+            t.offsets[w + 1]++;
+        for (int v = 0; v < vertices; ++v)
+            t.offsets[v + 1] += t.offsets[v];
+        t.targets.resize(targets.size());
+        vector<int64_t> cursor(t.offsets.begin(), t.offsets.end() - 1);
+        for (int v = 0; v < vertices; ++v)
+            for (int64_t e = offsets[v]; e < offsets[v + 1]; ++e)
+                t.targets[cursor[targets[e]]++] = v;
+        return t;
+    }
+};
+
+#endif
@@ -0,0 +1,122 @@
+#ifndef DIRECTION_BFS_HPP
+#define DIRECTION_BFS_HPP
+
+#include <chrono>
+#include <cstdint>
+#include <vector>
+#include "csr_graph.hpp"
+
+using namespace std;
+
+struct BfsLevelStats {
+    int level;
+    bool bottomUp;
+    int64_t frontier;       // vértices na fronteira que gerou este nível
+    int64_t edgesInspected; // arestas olhadas para montar o nível
+    double milliseconds;
+};
+
+struct BfsStats {
+    vector<BfsLevelStats> levels;
+    int64_t edgesInspected = 0;
+};
+
+// Parâmetros de troca de direção de Beamer et al.: desce para bottom-up
+// quando a fronteira está crescendo e suas arestas passam de 1/alpha das
+// arestas ainda não exploradas, e volta para top-down quando a fronteira cai abaixo de
+// n / beta vértices e está encolhendo.
+struct DirectionParams {
+    double alpha = 14;
+    double beta = 24;
+    bool allowBottomUp = true;
+};
+
+// BFS com otimização de direção sobre um grafo não dirigido em CSR.
+//   top-down:  cada vértice da fronteira (fila) marca os vizinhos novos;
+//   bottom-up: cada vértice não visitado procura um vizinho no bitmap da
+//              fronteira e para no primeiro, o que corta a maior parte das
+//              arestas nos níveis largos de grafos de diâmetro pequeno.
+// Distâncias inalcançáveis ficam em unreachable.
+inline void directionOptimizingBfs(const CSRGraph &g, int start, vector<int> &distances, int unreachable,
+                                   BfsStats *stats = nullptr, DirectionParams params = DirectionParams()) {
+    int n = g.vertices;
+    distances.assign(n, unreachable);
+    vector<int> frontier{start}, next;
+    vector<uint64_t> frontierBits((n + 63) / 64, 0), nextBits((n + 63) / 64, 0);
+    distances[start] = 0;
+    if (stats)
+        *stats = BfsStats();
+
+    int64_t unexploredEdges = g.edgeCount() - g.outDegree(start);
+    int64_t frontierEdges = g.outDegree(start);
+    int64_t frontierSize = 1, lastFrontierSize = 0;
+    bool bottomUp = false;
+
+    for (int level = 0; frontierSize > 0; ++level) {
+        auto begin = chrono::steady_clock::now();
+        int64_t inspected = 0;
+        int64_t previousSize = frontierSize;
+
+        if (params.allowBottomUp) {
+            if (!bottomUp && frontierEdges > unexploredEdges / params.alpha && frontierSize > lastFrontierSize) {
+                bottomUp = true;
+                fill(frontierBits.begin(), frontierBits.end(), 0);
+                for (int u : frontier)
+                    frontierBits[u / 64] |= 1ULL << (u % 64);
+            } else if (bottomUp && frontierSize < n / params.beta && frontierSize < lastFrontierSize) {
+                bottomUp = false;
+                frontier.clear();
+                for (int k = 0; k < (int)frontierBits.size(); ++k)
+                    for (uint64_t b = frontierBits[k]; b; b &= b - 1)
+                        frontier.push_back(k * 64 + __builtin_ctzll(b));
+            }
+        }
+
+        frontierSize = 0;
+        frontierEdges = 0;
+        if (bottomUp) {
+            fill(nextBits.begin(), nextBits.end(), 0);
+            for (int v = 0; v < n; ++v) {
+                if (distances[v] != unreachable)
+                    continue;
+                for (int64_t e = g.begin(v); e < g.end(v); ++e) {
+                    int u = g.targets[e];
+                    inspected++;
+                    if ((frontierBits[u / 64] >> (u % 64)) & 1) {
+                        distances[v] = level + 1;
+                        nextBits[v / 64] |= 1ULL << (v % 64);
+                        frontierSize++;
+                        frontierEdges += g.outDegree(v);
+                        break;
+                    }
+                }
+            }
+            frontierBits.swap(nextBits);
+        } else {
+            next.clear();
+            for (int u : frontier) {
+                for (int64_t e = g.begin(u); e < g.end(u); ++e) {
+                    int v = g.targets[e];
+                    inspected++;
+                    if (distances[v] == unreachable) {
+                        distances[v] = level + 1;
+                        next.push_back(v);
+                        frontierEdges += g.outDegree(v);
+                    }
+                }
+            }
+            frontier.swap(next);
+            frontierSize = (int64_t)frontier.size();
+        }
+        unexploredEdges -= frontierEdges;
+        lastFrontierSize = previousSize;
+
+        if (stats) {
+            double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - begin).count();
+            stats->levels.push_back({level, bottomUp, previousSize, inspected, ms});
+            stats->edgesInspected += inspected;
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,188 @@
+#ifndef EDGE_CLASSIFICATION_HPP
+#define EDGE_CLASSIFICATION_HPP
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+#include "csr_graph.hpp"
+#include "scc.hpp"
+
+using namespace std;
+
+// Tipo de cada aresta na floresta da DFS, um byte por aresta.
+enum EdgeType : uint8_t
+{
+    TREE_EDGE = 0,
+    BACK_EDGE = 1,
+    FORWARD_EDGE = 2,
+    CROSS_EDGE = 3
+};
+
+static const char *const edgeTypeNames[] = {"tree", "back", "forward", "cross"};
+
+struct EdgeClassification
+{
+    vector<int> discoveryTime; // tempos de 1 a 2V, como no DFS recursivo
+    vector<int> finishTime;
+    vector<uint8_t> edgeType;  // indexado pelo id da aresta no CSR
+    int64_t counts[4] = {0, 0, 0, 0};
+};
+
+// DFS iterativa sobre todo o grafo, visitando as raízes em ordem crescente e
+// os vizinhos na ordem do CSR (mesma ordem do DFSVisit recursivo). A pilha
+// guarda só vértices; o próximo vizinho de cada um fica em um cursor plano.
+//   árvore:  vizinho ainda não descoberto
+//   retorno: vizinho descoberto e não finalizado (está na pilha; inclui laços)
+//   avanço:  vizinho finalizado, descoberto depois do vértice atual
+//   cruzada: vizinho finalizado, descoberto antes
+// Se scc não for nulo, a mesma passada roda Tarjan (lowlink + pilha de
+// componentes). As componentes fecham em ordem topológica reversa, então a
+// ordem topológica da condensação sai de graça.
+inline EdgeClassification classifyEdges(const CSRGraph &g, SCCResult *scc = nullptr)
+{
+    int n = g.vertices;
+    EdgeClassification r;
+    r.discoveryTime.assign(n, -1);
+    r.finishTime.assign(n, -1);
+    r.edgeType.assign(g.edgeCount(), TREE_EDGE);
+    vector<int64_t> cursor(g.offsets.begin(), g.offsets.end() - 1);
+    vector<int> stack;
+    int timeCounter = 0;
+
+    vector<int> low, sccStack;
+    vector<uint8_t> onSccStack;
+    if (scc)
+    {
+        low.assign(n, 0);
+        onSccStack.assign(n, 0);
+        scc->component.assign(n, -1);
+        scc->componentCount = 0;
+    }
+
+    for (int root = 0; root < n; ++root)
+    {
+        if (r.discoveryTime[root] != -1)
+            continue;
+        r.discoveryTime[root] = ++timeCounter;
+        stack.push_back(root);
+        if (scc)
+        {
+            low[root] = r.discoveryTime[root];
+            sccStack.push_back(root);
+            onSccStack[root] = 1;
+        }
+        while (!stack.empty())
+        {
+            int vertex = stack.back();
+            if (cursor[vertex] == g.end(vertex))
+            {
+                r.finishTime[vertex] = ++timeCounter;
+                stack.pop_back();
+                if (scc)
+                {
+                    if (low[vertex] == r.discoveryTime[vertex])
+                    {
+                        int id = scc->componentCount++;
+                        int w;
+                        do
+                        {
+                            w = sccStack.back();
+                            sccStack.pop_back();
+                            onSccStack[w] = 0;
+                            scc->component[w] = id;
+                        } while (w != vertex);
+                    }
+                    if (!stack.empty() && low[vertex] < low[stack.back()])
+                        low[stack.back()] = low[vertex];
+                }
+                continue;
+            }
+            int64_t e = cursor[vertex]++;
+            int neighbor = g.targets[e];
+            uint8_t type;
+            if (r.discoveryTime[neighbor] == -1)
+            {
+                type = TREE_EDGE;
+                r.discoveryTime[neighbor] = ++timeCounter;
+                stack.push_back(neighbor);
+                if (scc)
+                {
+                    low[neighbor] = r.discoveryTime[neighbor];
+                    sccStack.push_back(neighbor);
+                    onSccStack[neighbor] = 1;
+                }
+            }
+            else if (r.finishTime[neighbor] == -1)
+                type = BACK_EDGE;
+            else if (r.discoveryTime[vertex] < r.discoveryTime[neighbor])
+                type = FORWARD_EDGE;
+            else
+                type = CROSS_EDGE;
+            r.edgeType[e] = type;
+            r.counts[type]++;
+            if (scc && type != TREE_EDGE && onSccStack[neighbor] && r.discoveryTime[neighbor] < low[vertex])
+                low[vertex] = r.discoveryTime[neighbor];
+        }
+    }
+
+    if (scc)
+    {
+        vector<int> remap = canonicalizeComponents(scc->component, scc->componentCount);
+        scc->topologicalOrder.resize(scc->componentCount);
+        for (int i = 0; i < scc->componentCount; ++i)
+            scc->topologicalOrder[i] = remap[scc->componentCount - 1 - i];
+        scc->condensation = buildCondensation(g, scc->component, scc->componentCount);
+        scc->hasCycle = r.counts[BACK_EDGE] > 0;
+    }
+    return r;
+}
+
+// Escreve "Edge (u, v): tipo" para todas as arestas, em ordem de id,
+// formatando em um buffer grande e gravando em blocos com fwrite.
+inline void writeEdgeClassification(FILE *out, const CSRGraph &g, const vector<uint8_t> &types,
+                                    size_t bufferBytes = 1 << 20)
+{
+    vector<char> buffer(bufferBytes + 64);
+    size_t used = 0;
+    auto putInt = [&](int value)
+    {
+        char digits[12];
+        int len = 0;
+        do
+        {
+            digits[len++] = char('0' + value % 10);
+            value /= 10;
+        } while (value > 0);
+        while (len > 0)
+            buffer[used++] = digits[--len];
+    };
+    auto putText = [&](const char *text)
+    {
+        size_t len = strlen(text);
+        memcpy(&buffer[used], text, len);
+        used += len;
+    };
+    for (int u = 0; u < g.vertices; ++u)
+    {
+        for (int64_t e = g.begin(u); e < g.end(u); ++e)
+        {
+            putText("Edge (");
+            putInt(u);
+            putText(", ");
+            putInt(g.targets[e]);
+            putText("): ");
+            putText(edgeTypeNames[types[e]]);
+            buffer[used++] = '\n';
+            if (used >= bufferBytes)
+            {
+                fwrite(buffer.data(), 1, used, out);
+                used = 0;
+            }
+        }
+    }
+    fwrite(buffer.data(), 1, used, out);
+    fflush(out);
+}
+
+#endif
@@ -0,0 +1,237 @@
+#ifndef EXCENTRICITY_HPP
+#define EXCENTRICITY_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+#include "csr_graph.hpp"
+
+using namespace std;
+
+// Excentricidades de um grafo não dirigido em CSR (arestas nos dois
+// sentidos). Como no bfs da Questao02, a excentricidade de v é a maior
+// distância finita a partir de v; vértices inalcançáveis são ignorados.
+struct ExcentricityResult {
+    vector<int> excentricities;
+    int diameter = 0;
+    int radius = 0;
+    int64_t bfsLevels = 0; // níveis processados, somados sobre os lotes
+};
+
+// MS-BFS (multi-source BFS): um lote de 64 * W origens anda junto. Cada
+// vértice guarda W palavras de bits (bit i = origem i do lote):
+//   seen:  origens que já alcançaram o vértice
+//   visit: origens para as quais o vértice está na fronteira atual
+//   next:  origens que chegam ao vértice no próximo nível
+// Uma aresta é percorrida uma vez por nível para todas as origens do lote,
+// e o laço interno sobre W palavras é vetorizado pelo compilador.
+template <int W>
+void msbfsBatch(const CSRGraph &g, int firstSource, vector<int> &ecc, int64_t &levels,
+                vector<uint64_t> &seen, vector<uint64_t> &visit, vector<uint64_t> &next) {
+    int n = g.vertices;
+    int batch = min(64 * W, n - firstSource);
+    fill(seen.begin(), seen.end(), 0);
+    fill(visit.begin(), visit.end(), 0);
+    fill(next.begin(), next.end(), 0);
+    for (int i = 0; i < batch; ++i) {
+        int s = firstSource + i;
+        seen[(size_t)s * W + i / 64] |= 1ULL << (i % 64);
+        visit[(size_t)s * W + i / 64] |= 1ULL << (i % 64);
+        ecc[s] = 0;
+    }
+
+    for (int level = 1;; ++level) {
+        // Empurra a fronteira de cada vértice ativo para os vizinhos.
+        for (int v = 0; v < n; ++v) {
+            const uint64_t *fv = &visit[(size_t)v * W];
+            uint64_t any = 0;
+            for (int k = 0; k < W; ++k)
+                any |= fv[k];
+            if (!any)
+                continue;
+            for (int64_t e = g.begin(v); e < g.end(v); ++e) {
+                uint64_t *nu = &next[(size_t)g.targets[e] * W];
+                for (int k = 0; k < W; ++k)
+                    nu[k] |= fv[k];
+            }
+        }
+
+        // Fica só o que é novo; as origens que descobriram algo neste nível
+        // têm excentricidade pelo menos level.
+        uint64_t reached[W] = {};
+        for (int u = 0; u < n; ++u) {
+            uint64_t *nu = &next[(size_t)u * W];
+            uint64_t *su = &seen[(size_t)u * W];
+            uint64_t *vu = &visit[(size_t)u * W];
+            for (int k = 0; k < W; ++k) {
+                uint64_t fresh = nu[k] & ~su[k];
+                su[k] |= fresh;
+                vu[k] = fresh;
+                reached[k] |= fresh;
+                nu[k] = 0;
+            }
+        }
+
+        uint64_t any = 0;
+        for (int k = 0; k < W; ++k)
+            any |= reached[k];
+        if (!any)
+            break;
+        levels++;
+        for (int k = 0; k < W; ++k)
+            for (uint64_t bits = reached[k]; bits; bits &= bits - 1)
+                ecc[firstSource + 64 * k + __builtin_ctzll(bits)] = level;
+    }
+}
+
+// Todas as excentricidades por MS-BFS em lotes de 256 origens (64 quando o
+// grafo é pequeno, para não varrer palavras vazias).
+inline ExcentricityResult msbfsExcentricities(const CSRGraph &g) {
+    ExcentricityResult r;
+    int n = g.vertices;
+    r.excentricities.assign(n, 0);
+    if (n == 0)
+        return r;
+
+    const int wide = 4;
+    int words = n >= 64 * wide ? wide : 1;
+    vector<uint64_t> seen((size_t)n * words), visit((size_t)n * words), next((size_t)n * words);
+    for (int first = 0; first < n; first += 64 * words) {
+        if (words == wide)
+            msbfsBatch<wide>(g, first, r.excentricities, r.bfsLevels, seen, visit, next);
+        else
+            msbfsBatch<1>(g, first, r.excentricities, r.bfsLevels, seen, visit, next);
+    }
+
+    r.diameter = *max_element(r.excentricities.begin(), r.excentricities.end());
+    r.radius = *min_element(r.excentricities.begin(), r.excentricities.end());
+    return r;
+}
+
+// Diâmetro, raio, centro e periferia sem calcular todas as excentricidades
+// (BoundingDiameters de Takes e Kosters, a generalização do iFUB). Cada
+// vértice w guarda limites lower[w] <= ecc(w) <= upper[w]. Uma BFS a partir
+// de v dá ecc(v) e, pela desigualdade triangular, para cada w alcançado:
+//   lower[w] >= max(d(v, w), ecc(v) - d(v, w))
+//   upper[w] <= ecc(v) + d(v, w)
+// Um vértice sai dos candidatos quando os limites se encontram ou quando não
+// pode estar nem na periferia (upper < maior lower) nem no centro (lower >
+// menor upper). Com withSets = false só o diâmetro e o raio interessam, e as
+// desigualdades deixam de ser estritas: isso corta bem mais BFS, mas center
+// e periphery voltam vazios. As origens alternam entre o candidato de maior upper e o de
+// menor lower, desempatando pelo grau. Antes disso, uma varredura das
+// componentes conexas inicia os limites (upper <= tamanho - 1, lower >= 1
+// fora de vértices isolados), o que já descarta componentes pequenas sem BFS.
+struct ExtremesResult {
+    int diameter = 0;
+    int radius = 0;
+    vector<int> center;    // vértices com excentricidade igual ao raio
+    vector<int> periphery; // vértices com excentricidade igual ao diâmetro
+    int bfsRuns = 0;
+};
+
+inline ExtremesResult boundingExtremes(const CSRGraph &g, bool withSets = true) {
+    ExtremesResult r;
+    int n = g.vertices;
+    if (n == 0)
+        return r;
+
+    vector<int> lower(n, 0), upper(n, n), distances(n, -1), queue(n), candidates;
+    for (int root = 0; root < n; ++root) {
+        if (distances[root] != -1)
+            continue;
+        int head = 0, tail = 0;
+        distances[root] = 0;
+        queue[tail++] = root;
+        while (head < tail) {
+            int v = queue[head++];
+            for (int64_t e = g.begin(v); e < g.end(v); ++e)
+                if (distances[g.targets[e]] == -1) {
+                    distances[g.targets[e]] = 0;
+                    queue[tail++] = g.targets[e];
+                }
+        }
+        for (int i = 0; i < tail; ++i) {
+            lower[queue[i]] = tail > 1 ? 1 : 0;
+            upper[queue[i]] = tail - 1;
+        }
+    }
+    fill(distances.begin(), distances.end(), -1);
+    int maxLower = *max_element(lower.begin(), lower.end());
+    int minUpper = *min_element(upper.begin(), upper.end());
+    auto settled = [&](int w) {
+        if (lower[w] == upper[w])
+            return true;
+        if (withSets)
+            return upper[w] < maxLower && lower[w] > minUpper;
+        return upper[w] <= maxLower && lower[w] >= minUpper;
+    };
+    for (int v = 0; v < n; ++v)
+        if (!settled(v))
+            candidates.push_back(v);
+    bool pickHigh = true;
+
+    while (!candidates.empty()) {
+        int source = candidates[0];
+        for (int w : candidates) {
+            bool better;
+            if (pickHigh)
+                better = upper[w] > upper[source] || (upper[w] == upper[source] && g.outDegree(w) > g.outDegree(source));
+            else
+                better = lower[w] < lower[source] || (lower[w] == lower[source] && g.outDegree(w) > g.outDegree(source));
+            if (better)
+                source = w;
+        }
+        pickHigh = !pickHigh;
+
+        // BFS a partir da origem; distances só é limpo nos vértices tocados.
+        int head = 0, tail = 0;
+        distances[source] = 0;
+        queue[tail++] = source;
+        while (head < tail) {
+            int v = queue[head++];
+            for (int64_t e = g.begin(v); e < g.end(v); ++e) {
+                int w = g.targets[e];
+                if (distances[w] == -1) {
+                    distances[w] = distances[v] + 1;
+                    queue[tail++] = w;
+                }
+            }
+        }
+        r.bfsRuns++;
+        int ecc = distances[queue[tail - 1]];
+
+        for (int i = 0; i < tail; ++i) {
+            int w = queue[i], d = distances[w];
+            lower[w] = max(lower[w], max(d, ecc - d));
+            upper[w] = min(upper[w], ecc + d);
+            maxLower = max(maxLower, lower[w]);
+        }
+        lower[source] = upper[source] = ecc;
+        minUpper = n;
+        for (int v = 0; v < n; ++v)
+            minUpper = min(minUpper, upper[v]);
+        for (int i = 0; i < tail; ++i)
+            distances[queue[i]] = -1;
+
+        size_t k = 0;
+        for (int w : candidates)
+            if (!settled(w))
+                candidates[k++] = w;
+        candidates.resize(k);
+    }
+
+    // Sem candidatos, todo vértice que pode ser extremo tem valor exato.
+    r.diameter = maxLower;
+    r.radius = minUpper;
+    for (int v = 0; v < n && withSets; ++v) {
+        if (lower[v] == upper[v] && upper[v] == r.radius)
+            r.center.push_back(v);
+        if (lower[v] == upper[v] && lower[v] == r.diameter)
+            r.periphery.push_back(v);
+    }
+    return r;
+}
+
+#endif
@@ -0,0 +1,129 @@
+#ifndef GRAPH_GENERATORS_HPP
+#define GRAPH_GENERATORS_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+#include <vector>
+#include "csr_graph.hpp"
+
+using namespace std;
+
+// Geradores de grafos dirigidos com semente. Todos montam o CSR direto da
+// lista de arestas (contagem por origem) e eliminam repetições com
+// sort + unique em cada linha, sem tabela hash. Laços nunca são gerados.
+
+// G(n, m): exatamente m arestas distintas escolhidas uniformemente. As
+// repetições descartadas são repostas em novas rodadas de sorteio.
+inline CSRGraph generateGnm(int n, int64_t m, uint64_t seed)
+{
+    if (n < 2 || m > (int64_t)n * (n - 1))
+        throw invalid_argument("G(n, m): too many edges for the number of vertices");
+    mt19937_64 rng(seed);
+    uniform_int_distribution<int> pick(0, n - 1);
+    vector<pair<int, int>> edges;
+    CSRGraph g = CSRGraph::fromEdges(n, edges);
+    while (g.edgeCount() < m)
+    {
+        edges = g.edgeList();
+        while ((int64_t)edges.size() < m)
+        {
+            int u = pick(rng), v = pick(rng);
+            if (u != v)
+                edges.push_back({u, v});
+        }
+        g = CSRGraph::fromEdges(n, edges);
+        g.sortAndDeduplicate();
+    }
+    return g;
+}
+
+struct RMATParams
+{
+    double a = 0.57, b = 0.19, c = 0.19; // d = 1 - a - b - c
+};
+
+// R-MAT (Kronecker estocástico 2x2) sobre 2^scale vértices: cada aresta
+// desce scale níveis escolhendo um quadrante com probabilidades a, b, c, d.
+// Gera graus em lei de potência. São sorteadas m arestas; as repetidas e os
+// laços são descartados, como no gerador do Graph500.
+inline CSRGraph generateRMAT(int scale, int64_t m, uint64_t seed, RMATParams p = RMATParams())
+{
+    int n = 1 << scale;
+    mt19937_64 rng(seed);
+    uniform_real_distribution<double> coin(0.0, 1.0);
+    double ab = p.a + p.b, abc = p.a + p.b + p.c;
+    vector<pair<int, int>> edges(m);
+    for (auto &e : edges)
+    {
+        int u = 0, v = 0;
+        for (int bit = 0; bit < scale; ++bit)
+        {
+            double r = coin(rng);
+            int row = r >= ab, col = (r >= p.a && r < ab) || r >= abc;
+            u |= row << bit;
+            v |= col << bit;
+        }
+        e = {u, v};
+    }
+    // Embaralha os rótulos para que o grau não dependa do número do vértice.
+    vector<int> label(n);
+    for (int v = 0; v < n; ++v)
+        label[v] = v;
+    shuffle(label.begin(), label.end(), rng);
+    for (auto &e : edges)
+        e = {label[e.first], label[e.second]};
+    CSRGraph g = CSRGraph::fromEdges(n, edges);
+    g.sortAndDeduplicate();
+    return g;
+}
+
+// DAG sobre uma ordem topológica aleatória com uma fração controlada de
+// arestas invertidas: round(m * backEdgeRatio) arestas vão de um vértice
+// posterior para um anterior na ordem escondida, o resto vai para frente.
+// Com backEdgeRatio = 0 o grafo é acíclico. As arestas invertidas fecham
+// ciclos, mas a DFS pode classificar algumas delas como cruzadas.
+inline CSRGraph generateDAGWithBackEdges(int n, int64_t m, double backEdgeRatio, uint64_t seed)
+{
+    if (n < 2 || m > (int64_t)n * (n - 1) / 2)
+        throw invalid_argument("DAG: too many edges for the number of vertices");
+    mt19937_64 rng(seed);
+    uniform_int_distribution<int> pick(0, n - 1);
+    vector<int> order(n);
+    for (int v = 0; v < n; ++v)
+        order[v] = v;
+    shuffle(order.begin(), order.end(), rng);
+
+    // Sorteia pares (i < j) de posições distintos; a direção é decidida
+    // depois, então uma aresta nunca aparece nos dois sentidos.
+    int64_t backCount = (int64_t)(m * backEdgeRatio + 0.5);
+    vector<pair<int, int>> pairs;
+    CSRGraph positions = CSRGraph::fromEdges(n, pairs);
+    while (positions.edgeCount() < m)
+    {
+        pairs = positions.edgeList();
+        while ((int64_t)pairs.size() < m)
+        {
+            int i = pick(rng), j = pick(rng);
+            if (i != j)
+                pairs.push_back({min(i, j), max(i, j)});
+        }
+        positions = CSRGraph::fromEdges(n, pairs);
+        positions.sortAndDeduplicate();
+    }
+    pairs = positions.edgeList();
+    shuffle(pairs.begin(), pairs.end(), rng);
+
+    vector<pair<int, int>> edges(m);
+    for (int64_t k = 0; k < m; ++k)
+    {
+        int from = order[pairs[k].first], to = order[pairs[k].second];
+        edges[k] = k < backCount ? make_pair(to, from) : make_pair(from, to);
+    }
+    CSRGraph g = CSRGraph::fromEdges(n, edges);
+    g.sortAndDeduplicate();
+    return g;
+}
+
+#endif
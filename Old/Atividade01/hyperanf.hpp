@@ -0,0 +1,134 @@
+#ifndef HYPERANF_HPP
+#define HYPERANF_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+#include "csr_graph.hpp"
+
+using namespace std;
+
+// HyperANF (Boldi, Rosa e Vigna): aproximação da função de vizinhança
+// N(h) = número de pares (u, v) com d(u, v) <= h, sem BFS. Cada vértice tem
+// um contador HyperLogLog da sua bola B(u, h); como
+//   B(u, h + 1) = B(u, h) U (união de B(v, h) para v vizinho de u),
+// uma iteração é um máximo registrador a registrador sobre as arestas. As
+// arestas são percorridas na ordem do CSR (origem crescente), então as
+// escritas e a leitura de targets são sequenciais; só os contadores dos
+// vizinhos são lidos fora de ordem. Vizinhos cujo contador não mudou na
+// iteração anterior são pulados.
+struct HyperAnfResult {
+    vector<double> neighborhoodFunction; // N(0), N(1), ... até estabilizar
+    vector<int> excentricityEstimates;   // última iteração em que a bola cresceu
+    double effectiveDiameter = 0;        // menor h (interpolado) com N(h) >= 90% do total
+    double relativeStdError = 0;         // desvio relativo de cada contador: 1.04 / sqrt(m)
+    int registers = 0;
+    int iterations = 0;
+};
+
+inline uint64_t hyperAnfHash(uint64_t x) {
+    x += 0x9e3779b97f4a7c15ULL;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+}
+
+// Estimativa de cardinalidade de um contador, com a correção de contagem
+// linear para valores pequenos.
+inline double hyperLogLogEstimate(const uint8_t *counter, int m, const double *inversePowers) {
+    double sum = 0;
+    int zeros = 0;
+    for (int j = 0; j < m; ++j) {
+        sum += inversePowers[counter[j]];
+        zeros += counter[j] == 0;
+    }
+    double alpha = m == 16 ? 0.673 : m == 32 ? 0.697 : m == 64 ? 0.709 : 0.7213 / (1 + 1.079 / m);
+    double estimate = alpha * m * m / sum;
+    if (estimate <= 2.5 * m && zeros > 0)
+        estimate = m * log((double)m / zeros);
+    return estimate;
+}
+
+// log2Registers entre 4 e 16: m = 2^log2Registers registradores de um byte
+// por vértice; o erro cai com 1 / sqrt(m) e a memória cresce com m.
+inline HyperAnfResult hyperAnf(const CSRGraph &g, int log2Registers = 6, uint64_t seed = 1,
+                               int maxIterations = 1000) {
+    if (log2Registers < 4 || log2Registers > 16)
+        throw invalid_argument("HyperANF: log2Registers must be between 4 and 16");
+    int n = g.vertices;
+    int m = 1 << log2Registers;
+    HyperAnfResult r;
+    r.registers = m;
+    r.relativeStdError = 1.04 / sqrt((double)m);
+    r.excentricityEstimates.assign(n, 0);
+    if (n == 0)
+        return r;
+
+    double inversePowers[66];
+    for (int k = 0; k < 66; ++k)
+        inversePowers[k] = ldexp(1.0, -k);
+
+    vector<uint8_t> current((size_t)n * m, 0), next;
+    for (int v = 0; v < n; ++v) {
+        uint64_t h = hyperAnfHash((uint64_t)v ^ hyperAnfHash(seed));
+        int index = (int)(h >> (64 - log2Registers));
+        uint64_t rest = h << log2Registers;
+        int rank = rest == 0 ? 64 - log2Registers + 1 : __builtin_clzll(rest) + 1;
+        current[(size_t)v * m + index] = (uint8_t)rank;
+    }
+
+    auto total = [&](const vector<uint8_t> &counters) {
+        double sum = 0;
+        for (int v = 0; v < n; ++v)
+            sum += hyperLogLogEstimate(&counters[(size_t)v * m], m, inversePowers);
+        return sum;
+    };
+    r.neighborhoodFunction.push_back(total(current));
+
+    vector<uint8_t> changed(n, 1), changedNext(n);
+    for (int t = 1; t <= maxIterations; ++t) {
+        next = current;
+        bool any = false;
+        for (int u = 0; u < n; ++u) {
+            uint8_t *target = &next[(size_t)u * m];
+            bool grew = false;
+            for (int64_t e = g.begin(u); e < g.end(u); ++e) {
+                int v = g.targets[e];
+                if (!changed[v])
+                    continue;
+                const uint8_t *source = &current[(size_t)v * m];
+                uint8_t diff = 0;
+                for (int j = 0; j < m; ++j) {
+                    uint8_t merged = max(target[j], source[j]);
+                    diff |= merged ^ target[j];
+                    target[j] = merged;
+                }
+                grew = grew || diff != 0;
+            }
+            changedNext[u] = grew;
+            if (grew) {
+                r.excentricityEstimates[u] = t;
+                any = true;
+            }
+        }
+        if (!any)
+            break;
+        current.swap(next);
+        changed.swap(changedNext);
+        r.iterations = t;
+        r.neighborhoodFunction.push_back(total(current));
+    }
+
+    const vector<double> &nf = r.neighborhoodFunction;
+    double target = 0.9 * nf.back();
+    size_t h = 0;
+    while (nf[h] < target)
+        ++h;
+    r.effectiveDiameter = h == 0 ? 0 : (h - 1) + (target - nf[h - 1]) / (nf[h] - nf[h - 1]);
+    return r;
+}
+
+#endif
@@ -0,0 +1,268 @@
+#ifndef PARALLEL_SCC_HPP
+#define PARALLEL_SCC_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+#include "csr_graph.hpp"
+#include "scc.hpp"
+
+using namespace std;
+
+// Abaixo deste tamanho o laço roda na thread atual; criar threads custa mais
+// que o trabalho.
+static const int64_t PARALLEL_GRAIN = 1 << 14;
+
+// Divide [0, count) em blocos contíguos, um por thread, e chama
+// body(thread, inicio, fim). A thread atual processa o bloco 0.
+template <typename Body>
+void parallelFor(int threads, int64_t count, const Body &body, int64_t grain = PARALLEL_GRAIN)
+{
+    if (threads <= 1 || count < grain)
+    {
+        body(0, 0, count);
+        return;
+    }
+    int64_t chunk = (count + threads - 1) / threads;
+    vector<thread> workers;
+    for (int t = 1; t < threads; ++t)
+    {
+        int64_t b = min(count, t * chunk), e = min(count, b + chunk);
+        workers.emplace_back([&body, t, b, e]() { body(t, b, e); });
+    }
+    body(0, 0, min(count, chunk));
+    for (auto &w : workers)
+        w.join();
+}
+
+struct ParallelSCCStats
+{
+    int64_t trimmed = 0;       // componentes unitárias removidas pelo trim
+    int64_t pivotComponent = 0; // tamanho da componente achada por FW-BW
+    int bfsLevels = 0;         // níveis das duas BFS paralelas
+    int coloringRounds = 0;    // rodadas externas da coloração
+    int propagationSteps = 0;  // passos de propagação somados
+};
+
+// SCC paralelo em três fases (FW-BW-Trim + coloração):
+//   1. trim: remove em rodadas os vértices sem entrada ou sem saída ativa;
+//   2. FW-BW: BFS paralela para frente e para trás a partir de um pivô de
+//      grau alto; a interseção é a componente gigante dos grafos power-law;
+//   3. coloração: propaga o maior id para frente até estabilizar; cada
+//      vértice que manteve a própria cor é raiz, e a BFS reversa restrita à
+//      cor dele fecha a componente. Repete até não sobrar vértice ativo.
+// Os ids finais passam pela mesma canonicalização da versão sequencial, então
+// o vetor component é idêntico ao do Tarjan em classifyEdges.
+inline SCCResult parallelStronglyConnectedComponents(const CSRGraph &g, int threads,
+                                                     ParallelSCCStats *stats = nullptr)
+{
+    int n = g.vertices;
+    CSRGraph gt = g.transpose();
+    ParallelSCCStats local;
+    ParallelSCCStats &st = stats ? *stats : local;
+    st = ParallelSCCStats();
+
+    SCCResult result;
+    vector<int> &comp = result.component;
+    comp.assign(n, -1);
+    int nextId = 0;
+
+    vector<int> active(n);
+    for (int v = 0; v < n; ++v)
+        active[v] = v;
+    vector<vector<int>> perThread(max(threads, 1));
+
+    auto compactActive = [&]() {
+        size_t k = 0;
+        for (int v : active)
+            if (comp[v] == -1)
+                active[k++] = v;
+        active.resize(k);
+    };
+
+    // 1. Trim. As decisões de cada rodada são coletadas por thread e
+    //    aplicadas depois, então comp só é lido durante a fase paralela.
+    auto trim = [&]() {
+        while (true)
+        {
+            parallelFor(threads, (int64_t)active.size(), [&](int t, int64_t b, int64_t e) {
+                perThread[t].clear();
+                for (int64_t i = b; i < e; ++i)
+                {
+                    int v = active[i];
+                    bool hasOut = false, hasIn = false;
+                    for (int64_t k = g.begin(v); k < g.end(v) && !hasOut; ++k)
+                        hasOut = g.targets[k] != v && comp[g.targets[k]] == -1;
+                    for (int64_t k = gt.begin(v); k < gt.end(v) && hasOut && !hasIn; ++k)
+                        hasIn = gt.targets[k] != v && comp[gt.targets[k]] == -1;
+                    if (!hasOut || !hasIn)
+                        perThread[t].push_back(v);
+                }
+            });
+            int64_t removed = 0;
+            for (auto &list : perThread)
+            {
+                for (int v : list)
+                    comp[v] = nextId++;
+                removed += list.size();
+                list.clear();
+            }
+            if (removed == 0)
+                break;
+            st.trimmed += removed;
+            compactActive();
+        }
+    };
+    trim();
+
+    // 2. FW-BW a partir do vértice ativo com maior grau de entrada x saída.
+    if (!active.empty())
+    {
+        int pivot = active[0];
+        int64_t best = -1;
+        for (int v : active)
+        {
+            int64_t score = (int64_t)g.outDegree(v) * gt.outDegree(v);
+            if (score > best)
+                best = score, pivot = v;
+        }
+
+        vector<atomic<uint8_t>> reach(n);
+        for (int v : active)
+            reach[v].store(0, memory_order_relaxed);
+        auto bfs = [&](const CSRGraph &graph, uint8_t bit) {
+            vector<int> frontier{pivot};
+            reach[pivot].fetch_or(bit, memory_order_relaxed);
+            while (!frontier.empty())
+            {
+                st.bfsLevels++;
+                parallelFor(threads, (int64_t)frontier.size(), [&](int t, int64_t b, int64_t e) {
+                    perThread[t].clear();
+                    for (int64_t i = b; i < e; ++i)
+                    {
+                        int v = frontier[i];
+                        for (int64_t k = graph.begin(v); k < graph.end(v); ++k)
+                        {
+                            int w = graph.targets[k];
+                            if (comp[w] == -1 && !(reach[w].load(memory_order_relaxed) & bit) &&
+                                !(reach[w].fetch_or(bit, memory_order_relaxed) & bit))
+                                perThread[t].push_back(w);
+                        }
+                    }
+                });
+                frontier.clear();
+                for (auto &list : perThread)
+                {
+                    frontier.insert(frontier.end(), list.begin(), list.end());
+                    list.clear();
+                }
+            }
+        };
+        bfs(g, 1);
+        bfs(gt, 2);
+
+        int id = nextId++;
+        for (int v : active)
+            if (reach[v].load(memory_order_relaxed) == 3)
+            {
+                comp[v] = id;
+                st.pivotComponent++;
+            }
+        compactActive();
+        trim();
+    }
+
+    // 3. Coloração.
+    vector<atomic<int>> color(n);
+    for (int v = 0; v < n; ++v)
+        color[v].store(-1, memory_order_relaxed);
+    atomic<int> sharedId(nextId);
+    while (!active.empty())
+    {
+        st.coloringRounds++;
+        for (int v : active)
+            color[v].store(v, memory_order_relaxed);
+
+        atomic<bool> changed(true);
+        while (changed.load())
+        {
+            changed.store(false);
+            st.propagationSteps++;
+            parallelFor(threads, (int64_t)active.size(), [&](int, int64_t b, int64_t e) {
+                bool any = false;
+                for (int64_t i = b; i < e; ++i)
+                {
+                    int v = active[i];
+                    int c = color[v].load(memory_order_relaxed);
+                    for (int64_t k = g.begin(v); k < g.end(v); ++k)
+                    {
+                        atomic<int> &target = color[g.targets[k]];
+                        int old = target.load(memory_order_relaxed);
+                        while (old >= 0 && old < c && !target.compare_exchange_weak(old, c, memory_order_relaxed))
+                        {
+                        }
+                        if (old >= 0 && old < c)
+                            any = true;
+                    }
+                }
+                if (any)
+                    changed.store(true);
+            });
+        }
+
+        // Raízes: vértices que mantiveram a própria cor. Cada BFS reversa só
+        // toca vértices da cor da sua raiz, então as regiões são disjuntas.
+        vector<int> roots;
+        for (int v : active)
+            if (color[v].load(memory_order_relaxed) == v)
+                roots.push_back(v);
+        // As raízes são distribuídas dinamicamente: uma componente pode ser
+        // muito maior que as outras.
+        atomic<size_t> nextRoot(0);
+        int workers = active.size() >= (size_t)PARALLEL_GRAIN ? threads : 1;
+        parallelFor(workers, workers, [&](int, int64_t, int64_t) {
+            vector<int> queue;
+            size_t i;
+            while ((i = nextRoot.fetch_add(1, memory_order_relaxed)) < roots.size())
+            {
+                int r = roots[i];
+                int id = sharedId.fetch_add(1, memory_order_relaxed);
+                queue.assign(1, r);
+                comp[r] = id;
+                for (size_t q = 0; q < queue.size(); ++q)
+                {
+                    int v = queue[q];
+                    for (int64_t k = gt.begin(v); k < gt.end(v); ++k)
+                    {
+                        int w = gt.targets[k];
+                        if (color[w].load(memory_order_relaxed) == r && comp[w] == -1)
+                        {
+                            comp[w] = id;
+                            queue.push_back(w);
+                        }
+                    }
+                }
+            }
+        }, 1);
+        for (int v : active)
+            if (comp[v] != -1)
+                color[v].store(-1, memory_order_relaxed);
+        compactActive();
+    }
+    nextId = sharedId.load();
+
+    result.componentCount = nextId;
+    canonicalizeComponents(comp, nextId);
+    result.condensation = buildCondensation(g, comp, nextId);
+    result.topologicalOrder = topologicalSort(result.condensation);
+    result.hasCycle = nextId < n;
+    for (int v = 0; v < n && !result.hasCycle; ++v)
+        for (int64_t k = g.begin(v); k < g.end(v); ++k)
+            if (g.targets[k] == v)
+                result.hasCycle = true;
+    return result;
+}
+
+#endif
@@ -0,0 +1,96 @@
+#ifndef SCC_HPP
+#define SCC_HPP
+
+#include <cstdint>
+#include <vector>
+#include "csr_graph.hpp"
+
+using namespace std;
+
+// Componentes fortemente conexas e o DAG de condensação.
+// Os ids são canônicos: as componentes são numeradas pela ordem do menor
+// vértice de cada uma, então qualquer algoritmo que encontre a mesma partição
+// produz exatamente o mesmo vetor component.
+struct SCCResult
+{
+    vector<int> component;        // id da componente de cada vértice
+    int componentCount = 0;
+    CSRGraph condensation;        // uma aresta por par de componentes ligadas
+    vector<int> topologicalOrder; // ids das componentes em ordem topológica
+    bool hasCycle = false;        // alguma componente com 2+ vértices ou laço
+};
+
+// Renumera uma partição qualquer (ids de 0 a count - 1) para os ids canônicos.
+// Devolve o mapa id antigo -> id canônico.
+inline vector<int> canonicalizeComponents(vector<int> &component, int count)
+{
+    vector<int> remap(count, -1);
+    int next = 0;
+    for (int &c : component)
+    {
+        if (remap[c] == -1)
+            remap[c] = next++;
+        c = remap[c];
+    }
+    return remap;
+}
+
+// Monta o DAG de condensação em O(V + E): os vértices são agrupados por
+// componente com contagem, e as arestas repetidas são descartadas com um
+// marcador "última componente de origem" por componente de destino.
+inline CSRGraph buildCondensation(const CSRGraph &g, const vector<int> &component, int count)
+{
+    vector<int64_t> start(count + 1, 0);
+    for (int c : component)
+        start[c + 1]++;
+    for (int c = 0; c < count; ++c)
+        start[c + 1] += start[c];
+    vector<int> members(g.vertices);
+    vector<int64_t> cursor(start.begin(), start.end() - 1);
+    for (int v = 0; v < g.vertices; ++v)
+        members[cursor[component[v]]++] = v;
+
+    CSRGraph dag;
+    dag.vertices = count;
+    dag.offsets.assign(count + 1, 0);
+    vector<int> lastSource(count, -1);
+    for (int c = 0; c < count; ++c)
+    {
+        lastSource[c] = c; // ignora arestas internas
+        for (int64_t i = start[c]; i < start[c + 1]; ++i)
+        {
+            int v = members[i];
+            for (int64_t e = g.begin(v); e < g.end(v); ++e)
+            {
+                int d = component[g.targets[e]];
+                if (lastSource[d] != c)
+                {
+                    lastSource[d] = c;
+                    dag.targets.push_back(d);
+                }
+            }
+        }
+        dag.offsets[c + 1] = dag.edgeCount();
+    }
+    return dag;
+}
+
+// Ordem topológica do DAG pelo algoritmo de Kahn.
+inline vector<int> topologicalSort(const CSRGraph &dag)
+{
+    vector<int> indegree(dag.vertices, 0);
+    for (int d : dag.targets)
+        indegree[d]++;
+    vector<int> order;
+    order.reserve(dag.vertices);
+    for (int c = 0; c < dag.vertices; ++c)
+        if (indegree[c] == 0)
+            order.push_back(c);
+    for (size_t i = 0; i < order.size(); ++i)
+        for (int64_t e = dag.begin(order[i]); e < dag.end(order[i]); ++e)
+            if (--indegree[dag.targets[e]] == 0)
+                order.push_back(dag.targets[e]);
+    return order;
+}
+
+#endif